@@ -8,6 +8,8 @@
 #include "caf/actor_registry.hpp"
 #include "caf/actor_system.hpp"
 #include "caf/add_ref.hpp"
+#include "caf/detail/actor_slab.hpp"
+#include "caf/detail/aligned_alloc.hpp"
 #include "caf/detail/assert.hpp"
 #include "caf/detail/critical.hpp"
 #include "caf/detail/panic.hpp"
@@ -102,6 +104,18 @@ void actor_control_block::deref() noexcept {
                 get()->id());
 }
 
+void actor_control_block::deref_weak() noexcept {
+  auto& weak = ref_count_.weak_reference_count_ref();
+  if (weak.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    auto* slab = slab_;
+    this->~actor_control_block();
+    if (slab == nullptr)
+      detail::aligned_free(this);
+    else
+      slab->release();
+  }
+}
+
 error_code<sec> load_actor(strong_actor_ptr& ptr, actor_system* sys,
                            actor_id aid, const node_id& nid) {
   if (sys == nullptr)
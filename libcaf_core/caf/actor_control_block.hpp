@@ -128,9 +128,7 @@ public:
   }
 
   /// Decrements the weak reference count of this actor.
-  void deref_weak() noexcept {
-    ref_count_.dec_weak(this);
-  }
+  void deref_weak() noexcept;
 
   /// Tries to upgrade a weak reference to a strong reference.
   bool upgrade_weak() noexcept {
@@ -159,8 +157,13 @@ public:
 
 private:
   actor_control_block(actor_id aid, caf::node_id& nid, actor_system* sys,
-                      const meta::handler_list* iface)
-    : aid_(aid), nid_(std::move(nid)), system_(sys), iface_(iface) {
+                      const meta::handler_list* iface,
+                      detail::actor_slab* slab = nullptr)
+    : aid_(aid),
+      nid_(std::move(nid)),
+      system_(sys),
+      iface_(iface),
+      slab_(slab) {
     CAF_ASSERT(system_ != nullptr);
   }
 
@@ -179,6 +182,10 @@ private:
   /// Stores a pointer to the interface of the actor or `nullptr` if the actor
   /// is dynamically typed.
   const meta::handler_list* iface_;
+
+  /// Points to the slab that holds this control block or `nullptr` if the
+  /// control block has its own allocation.
+  detail::actor_slab* slab_;
 };
 
 static_assert(sizeof(actor_control_block)
@@ -14,6 +14,10 @@
 #include "caf/log/test.hpp"
 #include "caf/scoped_actor.hpp"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 using namespace caf;
 
 namespace {
@@ -62,4 +66,40 @@ TEST("serialization roundtrips go through the registry") {
   dispatch_messages();
 }
 
+TEST("threads may access ID-based entries concurrently") {
+  constexpr size_t num_actors = 256;
+  constexpr size_t num_threads = 4;
+  std::vector<actor> hdls;
+  for (size_t i = 0; i < num_actors; ++i)
+    hdls.push_back(sys.spawn(dummy));
+  auto& reg = sys.registry();
+  std::atomic<size_t> mismatches = 0;
+  std::vector<std::thread> threads;
+  for (size_t offset = 0; offset < num_threads; ++offset) {
+    threads.emplace_back([&, offset] {
+      for (auto i = offset; i < num_actors; i += num_threads) {
+        auto& hdl = hdls[i];
+        reg.put(hdl.id(), hdl);
+        // Each thread also reads entries owned by other threads.
+        auto other = hdls[(i + 1) % num_actors].id();
+        std::ignore = reg.get(other);
+        if (reg.get<actor>(hdl.id()) != hdl)
+          ++mismatches;
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  check_eq(mismatches.load(), 0u);
+  for (auto& hdl : hdls)
+    check_eq(reg.get<actor>(hdl.id()), hdl);
+  for (size_t i = 0; i < num_actors; i += 2)
+    reg.erase(hdls[i].id());
+  for (size_t i = 0; i < num_actors; ++i)
+    check_eq(reg.get(hdls[i].id()) == nullptr, i % 2 == 0);
+  for (auto& hdl : hdls)
+    anon_send_exit(hdl, exit_reason::user_shutdown);
+  dispatch_messages();
+}
+
 } // WITH_FIXTURE(test::fixture::deterministic)
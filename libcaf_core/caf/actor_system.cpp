@@ -11,6 +11,7 @@
 #include "caf/actor_system_config.hpp"
 #include "caf/console_printer.hpp"
 #include "caf/defaults.hpp"
+#include "caf/detail/actor_id_map.hpp"
 #include "caf/detail/actor_system_access.hpp"
 #include "caf/detail/actor_system_config_access.hpp"
 #include "caf/detail/assert.hpp"
@@ -27,6 +28,7 @@
 #include "caf/log/core.hpp"
 #include "caf/log/system.hpp"
 #include "caf/raise_error.hpp"
+#include "caf/resumable.hpp"
 #include "caf/scheduler.hpp"
 #include "caf/spawn_options.hpp"
 #include "caf/stateful_actor.hpp"
@@ -45,6 +47,7 @@
 #include <span>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace caf {
 
@@ -196,27 +199,17 @@ public:
   using shared_guard = std::shared_lock<std::shared_mutex>;
 
   void erase(actor_id key) override {
+    entries_.erase(key);
+  }
+
+  /// Removes a name mapping.
+  void erase(const std::string& key) override {
     // Stores a reference to the actor we're going to remove. This guarantees
     // that we aren't releasing the last reference to an actor while erasing it.
     // Releasing the final ref can trigger the actor to call its cleanup
     // function that in turn calls this function and we can end up in a
     // deadlock.
     strong_actor_ptr ref;
-    { // Lifetime scope of guard.
-      exclusive_guard guard{instances_mtx_};
-      auto i = entries_.find(key);
-      if (i != entries_.end()) {
-        ref.swap(i->second);
-        entries_.erase(i);
-      }
-    }
-  }
-
-  /// Removes a name mapping.
-  void erase(const std::string& key) override {
-    // Stores a reference to the actor we're going to remove for the same
-    // reasoning as in erase(actor_id).
-    strong_actor_ptr ref;
     { // Lifetime scope of guard.
       exclusive_guard guard{named_entries_mtx_};
       auto i = named_entries_.find(key);
@@ -241,10 +234,7 @@ public:
 
   // Stops this component.
   void stop() {
-    {
-      exclusive_guard guard{instances_mtx_};
-      entries_.clear();
-    }
+    entries_.clear();
     {
       exclusive_guard guard{named_entries_mtx_};
       named_entries_.clear();
@@ -253,10 +243,8 @@ public:
 
 private:
   strong_actor_ptr get_impl(actor_id key) const override {
-    shared_guard guard(instances_mtx_);
-    auto i = entries_.find(key);
-    if (i != entries_.end())
-      return i->second;
+    if (auto result = entries_.get(key))
+      return result;
     log::core::debug("key invalid, assume actor no longer exists: key = {}",
                      key);
     return nullptr;
@@ -266,11 +254,8 @@ private:
     auto lg = log::core::trace("key = {}", key);
     if (!val)
       return;
-    { // lifetime scope of guard
-      exclusive_guard guard(instances_mtx_);
-      if (!entries_.emplace(key, val).second)
-        return;
-    }
+    if (!entries_.put(key, val))
+      return;
     // attach functor without lock
     log::core::debug("added actor: key = {}", key);
     actor_registry* reg = this;
@@ -294,10 +279,7 @@ private:
     named_entries_.emplace(std::move(key), std::move(val));
   }
 
-  using entries = std::unordered_map<actor_id, strong_actor_ptr>;
-
-  mutable std::shared_mutex instances_mtx_;
-  entries entries_;
+  detail::actor_id_map entries_;
 
   name_map named_entries_;
   mutable std::shared_mutex named_entries_mtx_;
@@ -563,6 +545,10 @@ public:
     return ++ids_;
   }
 
+  actor_id next_actor_ids(size_t count) override {
+    return ids_.fetch_add(count) + 1;
+  }
+
   actor_id latest_actor_id() const override {
     return ids_.load();
   }
@@ -625,6 +611,37 @@ public:
     }
   }
 
+  void launch_batch(std::span<local_actor* const> ptrs, caf::scheduler* ctx,
+                    spawn_options options) override {
+    if (ptrs.empty())
+      return;
+    if (has_detach_flag(options) || has_lazy_init_flag(options)) {
+      for (auto* ptr : ptrs)
+        launch(ptr, ctx, options);
+      return;
+    }
+    if (!has_hide_flag(options)) {
+      for (auto* ptr : ptrs)
+        ptr->setf(abstract_actor::is_registered_flag);
+      auto count = running_actors_count_.fetch_add(ptrs.size()) + ptrs.size();
+      log::system::debug("actors {} to {} increased running count to {}",
+                         ptrs.front()->id(), ptrs.back()->id(), count);
+    }
+    // Hand all initialization jobs to the scheduler at once, which allows it
+    // to distribute them to its workers in chunks.
+    std::vector<resumable_ptr> jobs;
+    jobs.reserve(ptrs.size());
+    for (auto* ptr : ptrs) {
+      auto* job = ptr->as_resumable();
+      if (job == nullptr || job->pinned_scheduler() != nullptr) {
+        ptr->launch(nullptr, ctx);
+        continue;
+      }
+      jobs.emplace_back(job, add_ref);
+    }
+    ctx->schedule_batch(jobs, resumable::initialization_event_id);
+  }
+
 private:
   /// Used to generate ascending actor IDs.
   std::atomic<size_t> ids_;
@@ -838,6 +855,10 @@ actor_id actor_system::next_actor_id() {
   return impl_->next_actor_id();
 }
 
+actor_id actor_system::next_actor_ids(size_t count) {
+  return impl_->next_actor_ids(count);
+}
+
 actor_id actor_system::latest_actor_id() const {
   return impl_->latest_actor_id();
 }
@@ -960,6 +981,12 @@ void actor_system::do_launch(local_actor* ptr, caf::scheduler* ctx,
   impl_->launch(ptr, ctx, options);
 }
 
+void actor_system::do_launch_batch(std::span<local_actor* const> ptrs,
+                                   caf::scheduler* ctx,
+                                   spawn_options options) {
+  impl_->launch_batch(ptrs, ctx, options);
+}
+
 // -- callbacks for actor_system_access ----------------------------------------
 
 void actor_system::set_node(node_id id) {
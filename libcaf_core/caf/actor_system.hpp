@@ -12,10 +12,12 @@
 #include "caf/caf_deprecated.hpp"
 #include "caf/callback.hpp"
 #include "caf/console_printer.hpp"
+#include "caf/detail/actor_slab.hpp"
 #include "caf/detail/actor_system_impl.hpp"
 #include "caf/detail/core_export.hpp"
 #include "caf/detail/format.hpp"
 #include "caf/detail/init_fun_factory.hpp"
+#include "caf/detail/scope_guard.hpp"
 #include "caf/detail/set_thread_name.hpp"
 #include "caf/detail/spawn_fwd.hpp"
 #include "caf/detail/spawnable.hpp"
@@ -36,6 +38,7 @@
 #include <span>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace caf::net {
 
@@ -290,6 +293,9 @@ public:
   /// Returns a new actor ID.
   actor_id next_actor_id();
 
+  /// Reserves `count` consecutive actor IDs and returns the first one.
+  actor_id next_actor_ids(size_t count);
+
   /// Returns the last given actor ID.
   actor_id latest_actor_id() const;
 
@@ -336,6 +342,38 @@ public:
     return spawn_impl<C>(cfg, detail::spawn_fwd<Ts>(xs)...);
   }
 
+  /// Returns `count` new actors of type `C`, each constructed with copies of
+  /// `xs...`. Compared to calling `spawn` in a loop, this function reserves
+  /// all actor IDs at once, allocates the actors from contiguous memory slabs
+  /// and hands all actors to the scheduler in a single batch.
+  /// @note Actors from the same slab share their memory. The memory of a slab
+  ///       is released only after all of its actors are gone.
+  template <class C, spawn_options Os = no_spawn_options, class... Ts>
+    requires(is_unbound(Os))
+  std::vector<infer_handle_from_class_t<C>>
+  spawn_many(size_t count, const Ts&... xs) {
+    check_invariants<C>();
+    return spawn_many_impl<C>(count, Os, [](actor_config&) {}, xs...);
+  }
+
+  /// Returns `count` new functor-based actors, each running a copy of `fun`
+  /// with copies of `xs...` as arguments.
+  /// @copydetails spawn_many
+  template <spawn_options Os = no_spawn_options, class F, class... Ts>
+    requires(is_unbound(Os))
+  std::vector<infer_handle_from_fun_t<F>>
+  spawn_many(size_t count, F fun, const Ts&... xs) {
+    using impl = infer_impl_from_fun_t<F>;
+    check_invariants<impl>();
+    static_assert(detail::spawnable<F, impl, const Ts&...>(),
+                  "cannot spawn function-based actor with given arguments");
+    auto init = [&fun, &xs...](actor_config& cfg) {
+      detail::init_fun_factory<impl, F> fac;
+      cfg.init_fun = fac(F{fun}, xs...);
+    };
+    return spawn_many_impl<impl>(count, Os, init);
+  }
+
   /// Called by `spawn` when used to create a functor-based actor to select a
   /// proper implementation and then delegates to `spawn_impl`.
   /// @param cfg To-be-filled config for the actor.
@@ -469,6 +507,50 @@ public:
     return res;
   }
 
+  template <class C, class Init, class... Ts>
+  std::vector<infer_handle_from_class_t<C>>
+  spawn_many_impl(size_t count, spawn_options opts, Init init,
+                  const Ts&... xs) {
+    using handle_type = infer_handle_from_class_t<C>;
+    using traits = detail::control_block_traits<actor_control_block>;
+    std::vector<handle_type> result;
+    if (count == 0) {
+      return result;
+    }
+    result.reserve(count);
+    auto flags = static_cast<int>(opts)
+                 | static_cast<int>(C::forced_spawn_options);
+    auto* sched = &scheduler();
+    CAF_SET_LOGGER_SYS(this);
+    auto aid = next_actor_ids(count);
+    std::vector<local_actor*> ptrs;
+    ptrs.reserve(count);
+    detail::actor_slab* slab = nullptr;
+    size_t slab_pos = 0;
+    // Unused blocks of the current slab must be released when leaving this
+    // scope early, e.g., because a constructor has thrown.
+    detail::scope_guard guard{[&slab, &slab_pos]() noexcept {
+      if (slab != nullptr && slab_pos < slab->capacity())
+        slab->release(slab->capacity() - slab_pos);
+    }};
+    for (size_t index = 0; index < count; ++index) {
+      if (slab == nullptr || slab_pos == slab->capacity()) {
+        slab = detail::actor_slab::make(traits::block_size<C>(),
+                                        count - index);
+        slab_pos = 0;
+      }
+      actor_config cfg{static_cast<spawn_options>(flags), sched};
+      cfg.mbox_factory = mailbox_factory();
+      init(cfg);
+      auto hdl = make_actor_at<C>(slab->block(slab_pos++), slab, aid++,
+                                  node(), this, cfg, xs...);
+      ptrs.push_back(actor_cast<C*>(hdl));
+      result.push_back(std::move(hdl));
+    }
+    do_launch_batch(ptrs, sched, static_cast<spawn_options>(flags));
+    return result;
+  }
+
   /// Creates a new, cooperatively scheduled actor. The returned actor is
   /// constructed but has not been added to the scheduler yet to allow the
   /// caller to set up any additional logic on the actor before it starts.
@@ -529,6 +611,9 @@ private:
 
   void do_launch(local_actor* ptr, caf::scheduler* ctx, spawn_options options);
 
+  void do_launch_batch(std::span<local_actor* const> ptrs, caf::scheduler* ctx,
+                       spawn_options options);
+
   // -- callbacks for actor_system_access --------------------------------------
 
   void set_node(node_id id);
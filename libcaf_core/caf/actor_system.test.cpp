@@ -8,14 +8,39 @@
 
 #include "caf/actor_system_config.hpp"
 #include "caf/event_based_actor.hpp"
+#include "caf/log/test.hpp"
 #include "caf/scoped_actor.hpp"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 using namespace caf;
+using namespace std::literals;
 
 using shared_bool_ptr = std::shared_ptr<bool>;
 
+namespace {
+
+class adder : public event_based_actor {
+public:
+  adder(actor_config& cfg, int summand)
+    : event_based_actor(cfg), summand_(summand) {
+    // nop
+  }
+
+  behavior make_behavior() override {
+    return {
+      [this](int x) { return x + summand_; },
+    };
+  }
+
+private:
+  int summand_;
+};
+
+} // namespace
+
 TEST("spawn_inactive creates an actor without launching it") {
   actor_system_config cfg;
   put(cfg.content, "caf.scheduler.max-threads", 1);
@@ -49,6 +74,45 @@ TEST("spawn_inactive creates an actor without launching it") {
   //       on to a reference as well that may not be dropped yet.
 }
 
+TEST("spawn_many creates actors with consecutive IDs") {
+  for (auto policy : {"sharing"s, "stealing"s}) {
+    log::test::debug("policy: {}", policy);
+    actor_system_config cfg;
+    put(cfg.content, "caf.scheduler.max-threads", 2);
+    put(cfg.content, "caf.scheduler.policy", policy);
+    actor_system sys{cfg};
+    scoped_actor self{sys};
+    // Class-based actors.
+    auto first_id = sys.latest_actor_id() + 1;
+    auto adders = sys.spawn_many<adder>(500, 10);
+    require_eq(adders.size(), 500u);
+    for (size_t i = 0; i < adders.size(); ++i)
+      check_eq(adders[i].id(), first_id + i);
+    for (auto& hdl : adders) {
+      self->mail(32).request(hdl, infinite).receive(
+        [this](int x) { check_eq(x, 42); },
+        [this](const error& err) { fail("unexpected error: {}", err); });
+    }
+    // Function-based actors.
+    auto fn = [](int summand) -> behavior {
+      return {[summand](int x) { return x + summand; }};
+    };
+    auto workers = sys.spawn_many(300, fn, 20);
+    require_eq(workers.size(), 300u);
+    check_eq(workers.front().id(), adders.back().id() + 1);
+    for (auto& hdl : workers) {
+      self->mail(22).request(hdl, infinite).receive(
+        [this](int x) { check_eq(x, 42); },
+        [this](const error& err) { fail("unexpected error: {}", err); });
+    }
+    // Spawning zero actors is a no-op.
+    check(sys.spawn_many<adder>(0, 10).empty());
+    // Dropping all handles terminates the actors and releases their slabs.
+    adders.clear();
+    workers.clear();
+  }
+}
+
 namespace {
 
 class test_console_printer : public console_printer {
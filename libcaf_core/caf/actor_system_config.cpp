@@ -143,9 +143,23 @@ actor_system_config::actor_system_config() {
                  "frequency of relaxed steal attempts")
     .add<timespan>("relaxed-sleep-duration",
                    "sleep duration between relaxed steal attempts");
+  opt_group{custom_options_, "caf.stream"}
+    .add<std::string>("credit-policy",
+                      "'size-based' (default) or 'token-based'");
+  opt_group{custom_options_, "caf.stream.size-policy"}
+    .add<int32_t>("bytes-per-batch", "desired batch size in Bytes")
+    .add<int32_t>("buffer-capacity", "maximum input buffer size in Bytes")
+    .add<int32_t>("sampling-rate", "frequency of collecting batch sizes")
+    .add<int32_t>("calibration-interval", "frequency of re-calibrations")
+    .add<double>("smoothing-factor", "factor for discounting older samples")
+    .add<timespan>("latency-budget",
+                   "maximum time for processing all buffered items");
   opt_group{custom_options_, "caf.logger.file"}
     .add<std::string>("path", "filesystem path for the log file")
     .add<std::string>("format", "format for individual log file entries")
+    .add<std::string>("encoding", "'text' (default) or 'binary'")
+    .add<size_t>("segment-size", "size of a single binary log segment")
+    .add<size_t>("max-segments", "nr. of binary log segments before rotating")
     .add<std::string>("verbosity", "minimum severity level for file output")
     .add<std::vector<std::string>>("excluded-components",
                                    "excluded components in files");
@@ -202,11 +216,25 @@ settings actor_system_config::dump_content() const {
               defaults::work_stealing::relaxed_steal_interval);
   put_missing(work_stealing_group, "relaxed-sleep-duration",
               defaults::work_stealing::relaxed_sleep_duration);
+  // -- stream parameters
+  auto& stream_group = caf_group["stream"].as_dictionary();
+  put_missing(stream_group, "credit-policy", defaults::stream::credit_policy);
+  namespace sp = defaults::stream::size_policy;
+  auto& size_policy_group = stream_group["size-policy"].as_dictionary();
+  put_missing(size_policy_group, "bytes-per-batch", sp::bytes_per_batch);
+  put_missing(size_policy_group, "buffer-capacity", sp::buffer_capacity);
+  put_missing(size_policy_group, "sampling-rate", sp::sampling_rate);
+  put_missing(size_policy_group, "calibration-interval",
+              sp::calibration_interval);
+  put_missing(size_policy_group, "smoothing-factor",
+              static_cast<double>(sp::smoothing_factor));
+  put_missing(size_policy_group, "latency-budget", sp::latency_budget);
   // -- logger parameters
   auto& logger_group = caf_group["logger"].as_dictionary();
   auto& file_group = logger_group["file"].as_dictionary();
   put_missing(file_group, "path", defaults::logger::file::path);
   put_missing(file_group, "format", defaults::logger::file::format);
+  put_missing(file_group, "encoding", defaults::logger::file::encoding);
   put_missing(file_group, "excluded-components", std::vector<std::string>{});
   auto& console_group = logger_group["console"].as_dictionary();
   put_missing(console_group, "colored", defaults::logger::console::colored);
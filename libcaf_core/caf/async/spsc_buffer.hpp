@@ -16,6 +16,7 @@
 #include "caf/detail/atomic_ref_count.hpp"
 #include "caf/disposable.hpp"
 #include "caf/error.hpp"
+#include "caf/flow/fwd.hpp"
 #include "caf/intrusive_ptr.hpp"
 #include "caf/mailbox_element.hpp"
 #include "caf/make_counted.hpp"
@@ -333,8 +334,13 @@ public:
       }
       guard.unlock();
       auto items = std::span<const T>{consumer_buf_.data(), n};
-      for (auto& item : items)
-        dst.on_next(item);
+      if constexpr (std::is_same_v<Observer, flow::observer<T>>) {
+        // Flow observers may process all items at once.
+        dst.on_next(items);
+      } else {
+        for (auto& item : items)
+          dst.on_next(item);
+      }
       demand -= n;
       consumed += n;
       consumer_buf_.clear();
@@ -79,6 +79,11 @@ constexpr auto calibration_interval = int32_t{20};
 /// adjusting batch sizes. A higher factor discounts older observations faster.
 constexpr auto smoothing_factor = 0.6f;
 
+/// Maximum time that a consumer should need for processing all items that an
+/// inbound path may buffer. The controller restricts the credit based on the
+/// measured processing rate of the consumer.
+constexpr auto latency_budget = timespan{100'000'000}; // 100ms
+
 } // namespace caf::defaults::stream::size_policy
 
 namespace caf::defaults::stream::token_policy {
@@ -115,6 +120,9 @@ namespace caf::defaults::logger::file {
 constexpr auto format = std::string_view{"%r %c %p %a %t %M %F:%L %m%n"};
 constexpr auto path
   = std::string_view{"actor_log_[PID]_[TIMESTAMP]_[NODE].log"};
+constexpr auto encoding = std::string_view{"text"};
+constexpr auto segment_size = size_t{64 * 1024 * 1024};
+constexpr auto max_segments = size_t{4};
 
 } // namespace caf::defaults::logger::file
 
@@ -0,0 +1,200 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/actor_id_map.hpp"
+
+#include "caf/detail/assert.hpp"
+#include "caf/detail/epoch_reclamation.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <vector>
+
+namespace caf::detail {
+
+// -- nested types -------------------------------------------------------------
+
+actor_id_map::table::table(size_t capacity)
+  : capacity(capacity), slots(new slot[capacity]) {
+  CAF_ASSERT(std::has_single_bit(capacity));
+}
+
+actor_id_map::table::~table() {
+  delete[] slots;
+}
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+actor_id_map::actor_id_map() {
+  for (auto& x : shards_)
+    x.tbl = new table(initial_capacity);
+}
+
+actor_id_map::~actor_id_map() {
+  for (auto& x : shards_) {
+    auto* tbl = x.tbl.load();
+    for (size_t index = 0; index < tbl->capacity; ++index)
+      if (auto* ptr = tbl->slots[index].value.load())
+        release_actor(ptr);
+    delete tbl;
+  }
+}
+
+// -- lookups ------------------------------------------------------------------
+
+strong_actor_ptr actor_id_map::get(actor_id key) const {
+  epoch_guard guard;
+  // Use sequentially consistent loads, because epoch-based reclamation
+  // requires a total order with unlinking objects and advancing epochs.
+  auto* tbl = shards_[shard_index(key)].tbl.load();
+  auto mask = tbl->capacity - 1;
+  for (auto index = probe_start(*tbl, key);; index = (index + 1) & mask) {
+    auto& x = tbl->slots[index];
+    auto slot_key = x.key.load();
+    if (slot_key == key) {
+      // The map holds a strong reference until no reader may access the
+      // actor anymore. Hence, incrementing the reference count is safe here.
+      return strong_actor_ptr{x.value.load(), add_ref};
+    }
+    if (slot_key == invalid_actor_id)
+      return nullptr;
+  }
+}
+
+// -- modifiers ----------------------------------------------------------------
+
+bool actor_id_map::put(actor_id key, const strong_actor_ptr& val) {
+  CAF_ASSERT(key != invalid_actor_id);
+  CAF_ASSERT(val != nullptr);
+  auto& x = shards_[shard_index(key)];
+  table* old_tbl = nullptr;
+  auto added = false;
+  { // Lifetime scope of guard.
+    std::lock_guard guard{x.mtx};
+    auto* tbl = x.tbl.load(std::memory_order_relaxed);
+    // Keep the load factor at or below 50%, which also guarantees that probing
+    // always finds an unused slot.
+    if (2 * (tbl->used + 1) > tbl->capacity) {
+      old_tbl = tbl;
+      tbl = rehash(*tbl);
+      x.tbl.store(tbl);
+    }
+    auto mask = tbl->capacity - 1;
+    for (auto index = probe_start(*tbl, key);; index = (index + 1) & mask) {
+      auto& entry = tbl->slots[index];
+      auto slot_key = entry.key.load(std::memory_order_relaxed);
+      if (slot_key == key) {
+        if (entry.value.load(std::memory_order_relaxed) == nullptr) {
+          entry.value.store(strong_actor_ptr{val}.release(),
+                            std::memory_order_release);
+          ++tbl->live;
+          added = true;
+        }
+        break;
+      }
+      if (slot_key == invalid_actor_id) {
+        // Store the value first. Readers that see the key also see the value.
+        entry.value.store(strong_actor_ptr{val}.release(),
+                          std::memory_order_relaxed);
+        entry.key.store(key, std::memory_order_release);
+        ++tbl->used;
+        ++tbl->live;
+        added = true;
+        break;
+      }
+    }
+  }
+  if (old_tbl != nullptr)
+    epoch_retire(old_tbl, delete_table);
+  return added;
+}
+
+bool actor_id_map::erase(actor_id key) {
+  auto& x = shards_[shard_index(key)];
+  actor_control_block* ptr = nullptr;
+  { // Lifetime scope of guard.
+    std::lock_guard guard{x.mtx};
+    auto* tbl = x.tbl.load(std::memory_order_relaxed);
+    auto mask = tbl->capacity - 1;
+    for (auto index = probe_start(*tbl, key);; index = (index + 1) & mask) {
+      auto& entry = tbl->slots[index];
+      auto slot_key = entry.key.load(std::memory_order_relaxed);
+      if (slot_key == key) {
+        ptr = entry.value.exchange(nullptr);
+        if (ptr != nullptr)
+          --tbl->live;
+        break;
+      }
+      if (slot_key == invalid_actor_id)
+        break;
+    }
+  }
+  // Releasing the reference may destroy the actor, which in turn may call
+  // `erase` again. Hence, we must not hold the lock at this point.
+  if (ptr == nullptr)
+    return false;
+  epoch_retire(ptr, release_actor);
+  return true;
+}
+
+void actor_id_map::clear() {
+  std::vector<table*> tables;
+  tables.reserve(num_shards);
+  for (auto& x : shards_) {
+    auto* tbl = new table(initial_capacity);
+    std::lock_guard guard{x.mtx};
+    tables.push_back(x.tbl.exchange(tbl));
+  }
+  // Wait for readers that may still access the old tables.
+  epoch_synchronize();
+  for (auto* tbl : tables) {
+    for (size_t index = 0; index < tbl->capacity; ++index)
+      if (auto* ptr = tbl->slots[index].value.load())
+        release_actor(ptr);
+    delete tbl;
+  }
+}
+
+// -- private utility ----------------------------------------------------------
+
+size_t actor_id_map::probe_start(const table& tbl, actor_id key) noexcept {
+  // Actor IDs are sequential and the lower bits select the shard. Hence, the
+  // remaining bits spread consecutive IDs over consecutive slots.
+  return static_cast<size_t>(key / num_shards) & (tbl.capacity - 1);
+}
+
+actor_id_map::table* actor_id_map::rehash(const table& tbl) {
+  auto capacity = std::max(initial_capacity,
+                           std::bit_ceil(4 * (tbl.live + 1)));
+  auto* result = new table(capacity);
+  auto mask = capacity - 1;
+  for (size_t pos = 0; pos < tbl.capacity; ++pos) {
+    auto& entry = tbl.slots[pos];
+    auto* ptr = entry.value.load(std::memory_order_relaxed);
+    if (ptr == nullptr)
+      continue;
+    auto key = entry.key.load(std::memory_order_relaxed);
+    auto index = probe_start(*result, key);
+    while (result->slots[index].key.load(std::memory_order_relaxed)
+           != invalid_actor_id)
+      index = (index + 1) & mask;
+    // The new table takes over the reference from the old table. Hence, the
+    // deleter of the old table must not release any actors.
+    result->slots[index].value.store(ptr, std::memory_order_relaxed);
+    result->slots[index].key.store(key, std::memory_order_relaxed);
+    ++result->used;
+    ++result->live;
+  }
+  return result;
+}
+
+void actor_id_map::delete_table(void* ptr) {
+  delete static_cast<table*>(ptr);
+}
+
+void actor_id_map::release_actor(void* ptr) {
+  static_cast<actor_control_block*>(ptr)->deref();
+}
+
+} // namespace caf::detail
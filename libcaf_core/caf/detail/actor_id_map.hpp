@@ -0,0 +1,115 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/abstract_actor.hpp"
+#include "caf/actor_control_block.hpp"
+#include "caf/config.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+
+namespace caf::detail {
+
+/// A concurrent hash map from actor IDs to actors. Lookups never block: they
+/// run without locks and use epoch-based reclamation to make sure that tables
+/// and actors remain valid while reading them. Modifications lock one of many
+/// shards, i.e., writers only contend with other writers of the same shard.
+class CAF_CORE_EXPORT actor_id_map {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// Number of shards. Must be a power of two.
+  static constexpr size_t num_shards = 32;
+
+  /// Number of slots in a freshly created table.
+  static constexpr size_t initial_capacity = 16;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  actor_id_map();
+
+  actor_id_map(const actor_id_map&) = delete;
+
+  actor_id_map& operator=(const actor_id_map&) = delete;
+
+  ~actor_id_map();
+
+  // -- lookups ----------------------------------------------------------------
+
+  /// Returns the actor for `key` or `nullptr`.
+  strong_actor_ptr get(actor_id key) const;
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Adds `val` under `key` unless the map already contains `key`.
+  /// @returns `true` if `val` was added, `false` otherwise.
+  /// @pre `key != invalid_actor_id && val != nullptr`
+  bool put(actor_id key, const strong_actor_ptr& val);
+
+  /// Removes `key` from the map.
+  /// @returns `true` if the map contained `key`, `false` otherwise.
+  bool erase(actor_id key);
+
+  /// Removes all entries and waits until concurrent readers are done, i.e.,
+  /// all references held by the map are released when this function returns.
+  void clear();
+
+private:
+  struct slot {
+    /// Stores the key or `invalid_actor_id` if this slot is unused. Removing
+    /// a key keeps it in the slot but resets its value. Since the actor system
+    /// never re-uses IDs, rehashing eventually drops these tombstones.
+    std::atomic<actor_id> key = invalid_actor_id;
+
+    /// Stores the actor. The map owns one strong reference to each actor.
+    std::atomic<actor_control_block*> value = nullptr;
+  };
+
+  struct table {
+    explicit table(size_t capacity);
+
+    ~table();
+
+    /// Number of slots. Always a power of two.
+    size_t capacity;
+
+    /// Number of slots with a key, including tombstones.
+    size_t used = 0;
+
+    /// Number of slots with a key and a value.
+    size_t live = 0;
+
+    slot* slots;
+  };
+
+  struct alignas(CAF_CACHE_LINE_SIZE) shard {
+    std::atomic<table*> tbl = nullptr;
+    std::mutex mtx;
+  };
+
+  static size_t shard_index(actor_id key) noexcept {
+    return key & (num_shards - 1);
+  }
+
+  // Returns the start position for probing the table for `key`.
+  static size_t probe_start(const table& tbl, actor_id key) noexcept;
+
+  // Copies all live entries into a new table with enough free slots for at
+  // least one more entry.
+  static table* rehash(const table& tbl);
+
+  static void delete_table(void* ptr);
+
+  static void release_actor(void* ptr);
+
+  std::array<shard, num_shards> shards_;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,123 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/actor_id_map.hpp"
+
+#include "caf/test/fixture/deterministic.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/actor.hpp"
+#include "caf/event_based_actor.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+behavior dummy() {
+  return {[](int i) { return i; }};
+}
+
+struct fixture : test::fixture::deterministic {
+  std::vector<actor> spawn_dummies(size_t n) {
+    std::vector<actor> result;
+    for (size_t i = 0; i < n; ++i)
+      result.push_back(sys.spawn(dummy));
+    return result;
+  }
+
+  ~fixture() {
+    for (auto& hdl : hdls)
+      anon_send_exit(hdl, exit_reason::user_shutdown);
+    dispatch_messages();
+  }
+
+  std::vector<actor> hdls;
+};
+
+} // namespace
+
+WITH_FIXTURE(fixture) {
+
+TEST("the map stores actors by their ID") {
+  detail::actor_id_map uut;
+  hdls = spawn_dummies(3);
+  check_eq(uut.get(hdls[0].id()), nullptr);
+  check(uut.put(hdls[0].id(), actor_cast<strong_actor_ptr>(hdls[0])));
+  check(uut.put(hdls[1].id(), actor_cast<strong_actor_ptr>(hdls[1])));
+  check(!uut.put(hdls[1].id(), actor_cast<strong_actor_ptr>(hdls[2])));
+  check_eq(uut.get(hdls[0].id()), actor_cast<strong_actor_ptr>(hdls[0]));
+  check_eq(uut.get(hdls[1].id()), actor_cast<strong_actor_ptr>(hdls[1]));
+  check_eq(uut.get(hdls[2].id()), nullptr);
+  check(uut.erase(hdls[0].id()));
+  check(!uut.erase(hdls[0].id()));
+  check_eq(uut.get(hdls[0].id()), nullptr);
+  // Adding a removed key again re-uses its slot.
+  check(uut.put(hdls[0].id(), actor_cast<strong_actor_ptr>(hdls[0])));
+  check_eq(uut.get(hdls[0].id()), actor_cast<strong_actor_ptr>(hdls[0]));
+  uut.clear();
+  for (auto& hdl : hdls)
+    check_eq(uut.get(hdl.id()), nullptr);
+}
+
+TEST("the map grows and drops removed entries when rehashing") {
+  detail::actor_id_map uut;
+  hdls = spawn_dummies(1000);
+  for (auto& hdl : hdls)
+    check(uut.put(hdl.id(), actor_cast<strong_actor_ptr>(hdl)));
+  for (size_t i = 0; i < hdls.size(); i += 2)
+    check(uut.erase(hdls[i].id()));
+  for (size_t i = 0; i < hdls.size(); ++i) {
+    if (i % 2 == 0)
+      check_eq(uut.get(hdls[i].id()), nullptr);
+    else
+      check_eq(uut.get(hdls[i].id()), actor_cast<strong_actor_ptr>(hdls[i]));
+  }
+}
+
+TEST("the map releases its references") {
+  hdls = spawn_dummies(1);
+  auto ptr = actor_cast<strong_actor_ptr>(hdls[0]);
+  auto baseline = ptr->strong_reference_count();
+  {
+    detail::actor_id_map uut;
+    uut.put(ptr->id(), ptr);
+    check_eq(ptr->strong_reference_count(), baseline + 1);
+  }
+  check_eq(ptr->strong_reference_count(), baseline);
+}
+
+TEST("readers may run concurrently to writers") {
+  detail::actor_id_map uut;
+  hdls = spawn_dummies(512);
+  std::atomic<bool> done = false;
+  std::atomic<size_t> invalid_results = 0;
+  std::vector<std::thread> readers;
+  for (size_t n = 0; n < 3; ++n) {
+    readers.emplace_back([&] {
+      while (!done) {
+        for (auto& hdl : hdls) {
+          auto ptr = uut.get(hdl.id());
+          if (ptr != nullptr && ptr != actor_cast<strong_actor_ptr>(hdl))
+            ++invalid_results;
+        }
+      }
+    });
+  }
+  for (int round = 0; round < 5; ++round) {
+    for (auto& hdl : hdls)
+      uut.put(hdl.id(), actor_cast<strong_actor_ptr>(hdl));
+    for (auto& hdl : hdls)
+      uut.erase(hdl.id());
+  }
+  done = true;
+  for (auto& reader : readers)
+    reader.join();
+  check_eq(invalid_results.load(), 0u);
+}
+
+} // WITH_FIXTURE(fixture)
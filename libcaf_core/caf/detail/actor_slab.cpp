@@ -0,0 +1,53 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/actor_slab.hpp"
+
+#include "caf/detail/aligned_alloc.hpp"
+#include "caf/detail/assert.hpp"
+#include "caf/raise_error.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace caf::detail {
+
+namespace {
+
+// The header occupies the first cache line of the slab.
+constexpr size_t header_size = actor_slab::padded_size(sizeof(actor_slab));
+
+} // namespace
+
+actor_slab::actor_slab(size_t block_size, size_t capacity) noexcept
+  : block_size_(block_size), capacity_(capacity), pending_(capacity) {
+  // nop
+}
+
+actor_slab* actor_slab::make(size_t block_size, size_t count) {
+  CAF_ASSERT(block_size % alignment == 0);
+  CAF_ASSERT(count > 0);
+  auto capacity = std::clamp(max_size / block_size, size_t{1}, count);
+  auto* mem = aligned_alloc(alignment, header_size + block_size * capacity);
+  if (mem == nullptr) {
+    CAF_RAISE_ERROR(std::bad_alloc, "failed to allocate an actor slab");
+  }
+  return new (mem) actor_slab(block_size, capacity);
+}
+
+void* actor_slab::block(size_t index) noexcept {
+  CAF_ASSERT(index < capacity_);
+  return reinterpret_cast<std::byte*>(this) + header_size
+         + index * block_size_;
+}
+
+void actor_slab::release(size_t count) noexcept {
+  CAF_ASSERT(count > 0);
+  if (pending_.fetch_sub(count, std::memory_order_acq_rel) == count) {
+    this->~actor_slab();
+    aligned_free(this);
+  }
+}
+
+} // namespace caf::detail
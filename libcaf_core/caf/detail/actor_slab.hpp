@@ -0,0 +1,76 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+#include "caf/detail/core_export.hpp"
+
+#include <atomic>
+#include <cstddef>
+
+namespace caf::detail {
+
+/// A contiguous memory region that stores the control blocks and actor objects
+/// for actors spawned in bulk. Each block releases its share of the slab once
+/// its weak reference count drops to zero and the last released block frees
+/// the entire region.
+/// @note A single long-running actor keeps its whole slab alive.
+class CAF_CORE_EXPORT actor_slab {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// Alignment of the slab and each of its blocks.
+  static constexpr size_t alignment = CAF_CACHE_LINE_SIZE;
+
+  /// Upper bound for the size of a single slab in bytes (unless a single block
+  /// exceeds this size).
+  static constexpr size_t max_size = 1024 * 1024;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  actor_slab(const actor_slab&) = delete;
+
+  actor_slab& operator=(const actor_slab&) = delete;
+
+  // -- factories --------------------------------------------------------------
+
+  /// Allocates a new slab for up to `count` blocks of `block_size` bytes each.
+  /// The slab may hold fewer than `count` blocks in order to respect
+  /// `max_size`. Callers must release each block exactly once, including
+  /// unused blocks.
+  /// @pre `block_size % alignment == 0 && count > 0`
+  static actor_slab* make(size_t block_size, size_t count);
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of blocks in this slab.
+  size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  /// Returns a pointer to the block at `index`.
+  void* block(size_t index) noexcept;
+
+  // -- reference counting -----------------------------------------------------
+
+  /// Releases `count` blocks and frees the slab when releasing the last block.
+  void release(size_t count = 1) noexcept;
+
+  // -- utility ----------------------------------------------------------------
+
+  /// Rounds `size` up to the next multiple of `alignment`.
+  static constexpr size_t padded_size(size_t size) noexcept {
+    return (size + alignment - 1) & ~(alignment - 1);
+  }
+
+private:
+  actor_slab(size_t block_size, size_t capacity) noexcept;
+
+  size_t block_size_;
+  size_t capacity_;
+  std::atomic<size_t> pending_;
+};
+
+} // namespace caf::detail
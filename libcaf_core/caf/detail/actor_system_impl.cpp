@@ -14,4 +14,11 @@ bool actor_system_impl::is_deterministic() const noexcept {
   return false;
 }
 
+void actor_system_impl::launch_batch(std::span<local_actor* const> ptrs,
+                                     caf::scheduler* ctx,
+                                     spawn_options options) {
+  for (auto* ptr : ptrs)
+    launch(ptr, ctx, options);
+}
+
 } // namespace caf::detail
@@ -81,6 +81,9 @@ public:
 
   virtual actor_id next_actor_id() = 0;
 
+  /// Reserves `count` consecutive actor IDs and returns the first one.
+  virtual actor_id next_actor_ids(size_t count) = 0;
+
   virtual actor_id latest_actor_id() const = 0;
 
   virtual size_t running_actors_count() const = 0;
@@ -106,6 +109,11 @@ public:
 
   virtual void launch(local_actor* ptr, caf::scheduler* ctx,
                       spawn_options options) = 0;
+
+  /// Launches all actors in `ptrs`. The default implementation calls `launch`
+  /// for each actor.
+  virtual void launch_batch(std::span<local_actor* const> ptrs,
+                            caf::scheduler* ctx, spawn_options options);
 };
 
 } // namespace caf::detail
@@ -11,6 +11,7 @@
 #include "caf/defaults.hpp"
 #include "caf/detail/actor_system_access.hpp"
 #include "caf/detail/atomic_ref_count.hpp"
+#include "caf/detail/binary_log_sink.hpp"
 #include "caf/detail/format.hpp"
 #include "caf/detail/get_process_id.hpp"
 #include "caf/detail/log_level_map.hpp"
@@ -496,6 +497,23 @@ public:
   bool open_file() {
     if (file_verbosity() == log::level::quiet || file_name_.empty())
       return false;
+    namespace lg = defaults::logger::file;
+    const auto& cfg = system_->config();
+    auto encoding = get_or(cfg, "caf.logger.file.encoding", lg::encoding);
+    if (icase_equal(encoding, "binary")) {
+      auto segment_size = get_or(cfg, "caf.logger.file.segment-size",
+                                 lg::segment_size);
+      auto max_segments = get_or(cfg, "caf.logger.file.max-segments",
+                                 lg::max_segments);
+      if (auto err = binary_sink_.open(file_name_, segment_size, max_segments,
+                                       t0_, log_level_names_);
+          err.valid()) {
+        fprintf(stderr, "unable to open binary log file %s: %s\n",
+                file_name_.c_str(), to_string(err).c_str());
+        return false;
+      }
+      return true;
+    }
     file_.reset(fopen(file_name_.c_str(), "a"));
     if (!file_) {
       fprintf(stderr, "unable to open log file %s\n", file_name_.c_str());
@@ -512,11 +530,15 @@ public:
   }
 
   void handle_file_event(const log::event& x) {
-    // Print to file if available.
-    if (file_ && x.level() <= file_verbosity()
-        && std::ranges::none_of(file_filter_, [&x](std::string_view name) {
+    if (x.level() > file_verbosity()
+        || std::ranges::any_of(file_filter_, [&x](std::string_view name) {
              return name == x.component();
-           })) {
+           }))
+      return;
+    // Write a binary record or print to file if available.
+    if (binary_sink_.valid()) {
+      binary_sink_.write(x);
+    } else if (file_) {
       buf_.clear();
       render(buf_, file_format_, x);
       buf_.write_to(file_.get());
@@ -608,6 +630,7 @@ public:
         handle_event(*next);
       } else {
         log_last_line();
+        binary_sink_.close();
         return;
       }
     }
@@ -698,6 +721,10 @@ public:
   // File handle for file output.
   file_ptr file_;
 
+  // Writes binary records to memory-mapped files instead of rendering text if
+  // the file encoding is set to 'binary'.
+  detail::binary_log_sink binary_sink_;
+
   // Handle for the console printer.
   placement_ptr<console_printer> console_printer_;
 
@@ -0,0 +1,267 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/binary_log_sink.hpp"
+
+#include "caf/detail/ieee_754.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <variant>
+
+namespace caf::detail {
+
+namespace {
+
+template <class T>
+void write_int(byte_buffer& buf, T value) {
+  using unsigned_t = std::make_unsigned_t<T>;
+  auto x = static_cast<unsigned_t>(value);
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    buf.push_back(static_cast<std::byte>(x & 0xFF));
+    x = static_cast<unsigned_t>(x >> 8);
+  }
+}
+
+template <class T>
+void write_int_at(std::byte* out, T value) {
+  using unsigned_t = std::make_unsigned_t<T>;
+  auto x = static_cast<unsigned_t>(value);
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    out[i] = static_cast<std::byte>(x & 0xFF);
+    x = static_cast<unsigned_t>(x >> 8);
+  }
+}
+
+void write_bytes(byte_buffer& buf, std::string_view str) {
+  auto* first = reinterpret_cast<const std::byte*>(str.data());
+  buf.insert(buf.end(), first, first + str.size());
+}
+
+int64_t to_nanoseconds(timestamp x) {
+  return x.time_since_epoch().count();
+}
+
+} // namespace
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+binary_log_sink::~binary_log_sink() {
+  close();
+}
+
+// -- open and close -----------------------------------------------------------
+
+error binary_log_sink::open(std::string path, size_t segment_size,
+                            size_t max_segments, timestamp t0,
+                            const log_level_map& levels) {
+  close();
+  path_ = std::move(path);
+  segment_size_ = std::max(segment_size, min_segment_size);
+  max_segments_ = std::max(max_segments, size_t{1});
+  index_ = 0;
+  sequence_ = 0;
+  t0_ = t0;
+  levels_ = levels;
+  scratch_.reserve(1024);
+  return open_segment();
+}
+
+void binary_log_sink::close() {
+  if (file_.valid())
+    file_.close(pos_);
+}
+
+std::string binary_log_sink::segment_path(size_t index) const {
+  auto result = path_;
+  result += '.';
+  result += std::to_string(index);
+  return result;
+}
+
+// -- writing ------------------------------------------------------------------
+
+void binary_log_sink::write(const log::event& x) {
+  if (!file_.valid())
+    return;
+  scratch_.clear();
+  encode(x);
+  if (pos_ + scratch_.size() > segment_size_) {
+    rotate();
+    if (!file_.valid())
+      return;
+    scratch_.clear();
+    encode(x);
+    if (pos_ + scratch_.size() > segment_size_) {
+      // The event is too large for a single segment. Forget about the strings
+      // we have interned while encoding it since we never write them.
+      static_strings_.clear();
+      strings_.clear();
+      next_id_ = 0;
+      return;
+    }
+  }
+  memcpy(file_.data() + pos_, scratch_.data(), scratch_.size());
+  pos_ += scratch_.size();
+}
+
+// -- segment management -------------------------------------------------------
+
+error binary_log_sink::open_segment() {
+  static_strings_.clear();
+  strings_.clear();
+  next_id_ = 0;
+  pos_ = 0;
+  // Re-opening an existing segment file first shrinks it to zero bytes in
+  // order to discard any previous content.
+  auto path = segment_path(index_);
+  if (auto err = file_.open(path, 0); err.valid())
+    return err;
+  if (auto err = file_.open(path, segment_size_); err.valid())
+    return err;
+  // Write the header.
+  auto* out = file_.data();
+  memcpy(out, magic.data(), magic.size());
+  write_int_at(out + 8, version);
+  write_int_at(out + 12, uint32_t{0});
+  write_int_at(out + 16, sequence_);
+  write_int_at(out + 24, to_nanoseconds(t0_));
+  pos_ = header_size;
+  // Write the level names.
+  scratch_.clear();
+  for (const auto& [level, name] : levels_.mapping())
+    encode_string_record(level_record, static_cast<uint32_t>(level), name);
+  if (pos_ + scratch_.size() <= segment_size_) {
+    memcpy(out + pos_, scratch_.data(), scratch_.size());
+    pos_ += scratch_.size();
+  }
+  return none;
+}
+
+void binary_log_sink::rotate() {
+  file_.close(pos_);
+  index_ = (index_ + 1) % max_segments_;
+  ++sequence_;
+  if (auto err = open_segment(); err.valid())
+    fprintf(stderr, "unable to open binary log segment %s: %s\n",
+            segment_path(index_).c_str(), to_string(err).c_str());
+}
+
+// -- encoding -----------------------------------------------------------------
+
+void binary_log_sink::encode(const log::event& x) {
+  // Emit string records first, since they may not nest in the event record.
+  auto component = intern(x.component());
+  auto file = intern(x.file_name());
+  auto function = intern(x.function_name());
+  intern_keys(x.fields());
+  begin_record(event_record);
+  write_int(scratch_, to_nanoseconds(x.timestamp()));
+  write_int(scratch_, static_cast<uint32_t>(x.level()));
+  write_int(scratch_, component);
+  write_int(scratch_, file);
+  write_int(scratch_, function);
+  write_int(scratch_, static_cast<uint32_t>(x.line_number()));
+  write_int(scratch_, static_cast<uint64_t>(x.actor_id()));
+  write_int(scratch_,
+            static_cast<uint64_t>(std::hash<std::thread::id>{}(x.thread_id())));
+  auto msg = x.message();
+  write_int(scratch_, static_cast<uint32_t>(msg.size()));
+  for (auto chunk : msg)
+    write_bytes(scratch_, chunk);
+  encode_fields(x.fields());
+  end_record();
+}
+
+void binary_log_sink::encode_fields(log::event::field_list fields) {
+  auto count_pos = scratch_.size();
+  write_int(scratch_, uint32_t{0});
+  uint32_t count = 0;
+  for (const auto& field : fields) {
+    ++count;
+    write_int(scratch_, intern(field.key));
+    auto fn = [this](const auto& value) {
+      using value_t = std::decay_t<decltype(value)>;
+      if constexpr (std::is_same_v<value_t, std::nullopt_t>) {
+        scratch_.push_back(std::byte{null_field});
+      } else if constexpr (std::is_same_v<value_t, bool>) {
+        scratch_.push_back(std::byte{bool_field});
+        scratch_.push_back(std::byte{value ? uint8_t{1} : uint8_t{0}});
+      } else if constexpr (std::is_same_v<value_t, int64_t>) {
+        scratch_.push_back(std::byte{int_field});
+        write_int(scratch_, value);
+      } else if constexpr (std::is_same_v<value_t, uint64_t>) {
+        scratch_.push_back(std::byte{uint_field});
+        write_int(scratch_, value);
+      } else if constexpr (std::is_same_v<value_t, double>) {
+        scratch_.push_back(std::byte{double_field});
+        write_int(scratch_, detail::pack754(value));
+      } else if constexpr (std::is_same_v<value_t, std::string_view>) {
+        scratch_.push_back(std::byte{string_field});
+        write_int(scratch_, static_cast<uint32_t>(value.size()));
+        write_bytes(scratch_, value);
+      } else if constexpr (std::is_same_v<value_t, chunked_string>) {
+        scratch_.push_back(std::byte{string_field});
+        write_int(scratch_, static_cast<uint32_t>(value.size()));
+        for (auto chunk : value)
+          write_bytes(scratch_, chunk);
+      } else {
+        static_assert(std::is_same_v<value_t, log::event::field_list>);
+        scratch_.push_back(std::byte{list_field});
+        encode_fields(value);
+      }
+    };
+    std::visit(fn, field.value);
+  }
+  write_int_at(scratch_.data() + count_pos, count);
+}
+
+void binary_log_sink::intern_keys(log::event::field_list fields) {
+  for (const auto& field : fields) {
+    intern(field.key);
+    if (auto* nested = std::get_if<log::event::field_list>(&field.value))
+      intern_keys(*nested);
+  }
+}
+
+void binary_log_sink::encode_string_record(record_type type, uint32_t id,
+                                           std::string_view str) {
+  begin_record(type);
+  write_int(scratch_, id);
+  write_bytes(scratch_, str);
+  end_record();
+}
+
+uint32_t binary_log_sink::intern(std::string_view str) {
+  if (auto i = strings_.find(str); i != strings_.end())
+    return i->second;
+  auto id = next_id_++;
+  strings_.emplace(std::string{str}, id);
+  encode_string_record(string_record, id, str);
+  return id;
+}
+
+uint32_t binary_log_sink::intern(const char* str) {
+  if (auto i = static_strings_.find(str); i != static_strings_.end())
+    return i->second;
+  auto id = next_id_++;
+  static_strings_.emplace(str, id);
+  encode_string_record(string_record, id, str);
+  return id;
+}
+
+void binary_log_sink::begin_record(record_type type) {
+  record_start_ = scratch_.size();
+  write_int(scratch_, uint32_t{0}); // Placeholder for the size.
+  scratch_.push_back(std::byte{type});
+}
+
+void binary_log_sink::end_record() {
+  auto size = scratch_.size() - record_start_ - sizeof(uint32_t);
+  write_int_at(scratch_.data() + record_start_, static_cast<uint32_t>(size));
+}
+
+} // namespace caf::detail
@@ -0,0 +1,211 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/byte_buffer.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/detail/log_level_map.hpp"
+#include "caf/detail/mapped_file.hpp"
+#include "caf/log/event.hpp"
+#include "caf/timestamp.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace caf::detail {
+
+/// Writes log events as compact binary records into a ring of memory-mapped
+/// segment files. Each segment is self-contained: component names, file names,
+/// function names and field keys are interned per segment and emitted as
+/// string records before their first use.
+///
+/// Segment layout (all integers in little-endian byte order):
+///
+/// ~~~
+/// header  := magic[8] version:u32 reserved:u32 sequence:u64 t0:i64
+/// record  := size:u32 type:u8 payload[size - 1]
+/// string  := id:u32 bytes[...]
+/// level   := level:u32 bytes[...]
+/// event   := timestamp:i64 level:u32 component:u32 file:u32 function:u32
+///            line:u32 actor:u64 thread:u64 message_size:u32 message[...]
+///            fields
+/// fields  := count:u32 (key:u32 tag:u8 value)*
+/// ~~~
+///
+/// A record size of zero marks the end of a segment. Timestamps are
+/// nanoseconds since the UNIX epoch.
+class CAF_CORE_EXPORT binary_log_sink {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// Identifies segment files written by this sink.
+  static constexpr std::string_view magic = std::string_view{"CAFBLOG\0", 8};
+
+  /// Version of the binary format.
+  static constexpr uint32_t version = 1;
+
+  /// Size of the segment header in bytes.
+  static constexpr size_t header_size = 32;
+
+  /// Minimum size of a single segment in bytes.
+  static constexpr size_t min_segment_size = 4096;
+
+  // -- member types -----------------------------------------------------------
+
+  /// Enables heterogeneous lookup of strings.
+  struct string_hash {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view str) const noexcept {
+      return std::hash<std::string_view>{}(str);
+    }
+  };
+
+  /// Identifies the type of a record.
+  enum record_type : uint8_t {
+    /// Marks the end of a segment.
+    end_of_segment = 0,
+    /// Assigns an ID to a string.
+    string_record = 1,
+    /// Maps a log level to its name.
+    level_record = 2,
+    /// Stores a single log event.
+    event_record = 3,
+  };
+
+  /// Identifies the type of a field value.
+  enum field_tag : uint8_t {
+    null_field = 0,
+    bool_field = 1,
+    int_field = 2,
+    uint_field = 3,
+    double_field = 4,
+    string_field = 5,
+    list_field = 6,
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  binary_log_sink() = default;
+
+  binary_log_sink(const binary_log_sink&) = delete;
+
+  binary_log_sink& operator=(const binary_log_sink&) = delete;
+
+  ~binary_log_sink();
+
+  // -- open and close ---------------------------------------------------------
+
+  /// Opens the first segment. Segments are written to `path.0` through
+  /// `path.N` with `N = max_segments - 1`. Once all segments are full, the
+  /// sink overwrites the oldest segment.
+  /// @param path The path prefix for all segment files.
+  /// @param segment_size The size of a single segment in bytes.
+  /// @param max_segments The maximum number of segment files.
+  /// @param t0 The start time of the logger.
+  /// @param levels Maps log levels to their names.
+  error open(std::string path, size_t segment_size, size_t max_segments,
+             timestamp t0, const log_level_map& levels);
+
+  /// Closes the current segment and truncates it to its used size.
+  void close();
+
+  // -- properties -------------------------------------------------------------
+
+  /// Checks whether the sink has an open segment.
+  [[nodiscard]] bool valid() const noexcept {
+    return file_.valid();
+  }
+
+  /// Returns the sequence number of the current segment.
+  [[nodiscard]] uint64_t sequence() const noexcept {
+    return sequence_;
+  }
+
+  /// Returns the path of the segment with index `index`.
+  [[nodiscard]] std::string segment_path(size_t index) const;
+
+  // -- writing ----------------------------------------------------------------
+
+  /// Appends `x` to the current segment, rotating to the next segment if
+  /// necessary. Drops events that do not fit into an empty segment.
+  void write(const log::event& x);
+
+private:
+  // -- segment management -----------------------------------------------------
+
+  error open_segment();
+
+  void rotate();
+
+  // -- encoding ---------------------------------------------------------------
+
+  void encode(const log::event& x);
+
+  void encode_fields(log::event::field_list fields);
+
+  void intern_keys(log::event::field_list fields);
+
+  void encode_string_record(record_type type, uint32_t id,
+                            std::string_view str);
+
+  uint32_t intern(std::string_view str);
+
+  uint32_t intern(const char* str);
+
+  void begin_record(record_type type);
+
+  void end_record();
+
+  // -- member variables -------------------------------------------------------
+
+  /// The prefix for all segment file names.
+  std::string path_;
+
+  /// The size of a single segment.
+  size_t segment_size_ = 0;
+
+  /// The maximum number of segment files.
+  size_t max_segments_ = 0;
+
+  /// The index of the current segment.
+  size_t index_ = 0;
+
+  /// The sequence number of the current segment.
+  uint64_t sequence_ = 0;
+
+  /// The write position in the current segment.
+  size_t pos_ = 0;
+
+  /// The start time of the logger.
+  timestamp t0_;
+
+  /// Maps log levels to their names.
+  log_level_map levels_;
+
+  /// The currently mapped segment.
+  mapped_file file_;
+
+  /// Encodes records before copying them to the mapped segment.
+  byte_buffer scratch_;
+
+  /// Stores the offset of the record currently encoded to `scratch_`.
+  size_t record_start_ = 0;
+
+  /// Interns strings with static storage duration by address.
+  std::unordered_map<const char*, uint32_t> static_strings_;
+
+  /// Interns all other strings by content.
+  std::unordered_map<std::string, uint32_t, string_hash, std::equal_to<>>
+    strings_;
+
+  /// The next ID for interned strings.
+  uint32_t next_id_ = 0;
+};
+
+} // namespace caf::detail
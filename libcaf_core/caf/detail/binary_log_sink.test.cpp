@@ -0,0 +1,302 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/binary_log_sink.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/detail/atomic_ref_count.hpp"
+#include "caf/detail/get_process_id.hpp"
+#include "caf/detail/ieee_754.hpp"
+#include "caf/detail/mapped_file.hpp"
+#include "caf/log/level.hpp"
+#include "caf/logger.hpp"
+
+#include <filesystem>
+#include <map>
+
+using namespace caf;
+using namespace std::literals;
+
+using detail::binary_log_sink;
+
+namespace {
+
+// A trivial logger implementation that stores the last event.
+class mock_logger : public logger {
+public:
+  log::event_ptr event;
+
+  void ref() const noexcept final {
+    ref_count_.inc();
+  }
+
+  void deref() const noexcept final {
+    ref_count_.dec(this);
+  }
+
+  bool accepts(unsigned, std::string_view) override {
+    return true;
+  }
+
+private:
+  void do_log(log::event_ptr&& ptr) override {
+    event = std::move(ptr);
+  }
+
+  mutable detail::atomic_ref_count ref_count_;
+};
+
+// Minimal decoder for the records written by the sink.
+class segment_reader {
+public:
+  explicit segment_reader(std::span<const std::byte> bytes) : bytes_(bytes) {
+    // nop
+  }
+
+  template <class T>
+  T read_int() {
+    using unsigned_t = std::make_unsigned_t<T>;
+    unsigned_t result = 0;
+    for (size_t i = 0; i < sizeof(T); ++i)
+      result |= static_cast<unsigned_t>(
+        static_cast<unsigned_t>(bytes_[pos_ + i]) << (8 * i));
+    pos_ += sizeof(T);
+    return static_cast<T>(result);
+  }
+
+  std::string read_string(size_t size) {
+    auto* first = reinterpret_cast<const char*>(bytes_.data() + pos_);
+    pos_ += size;
+    return std::string{first, size};
+  }
+
+  void skip(size_t n) {
+    pos_ += n;
+  }
+
+  size_t pos() const noexcept {
+    return pos_;
+  }
+
+  bool at_end() const noexcept {
+    return pos_ + sizeof(uint32_t) > bytes_.size();
+  }
+
+private:
+  std::span<const std::byte> bytes_;
+  size_t pos_ = 0;
+};
+
+struct decoded_event {
+  int64_t timestamp;
+  unsigned level;
+  std::string component;
+  std::string file;
+  std::string function;
+  uint32_t line;
+  uint64_t actor;
+  std::string message;
+  std::vector<std::pair<std::string, std::string>> fields;
+};
+
+struct decoded_segment {
+  uint32_t version = 0;
+  uint64_t sequence = 0;
+  int64_t t0 = 0;
+  std::map<unsigned, std::string> levels;
+  std::vector<decoded_event> events;
+};
+
+void decode_fields(segment_reader& src, std::map<uint32_t, std::string>& strs,
+                   std::vector<std::pair<std::string, std::string>>& out,
+                   const std::string& prefix) {
+  auto count = src.read_int<uint32_t>();
+  for (uint32_t i = 0; i < count; ++i) {
+    auto key = prefix + strs[src.read_int<uint32_t>()];
+    auto tag = src.read_int<uint8_t>();
+    switch (tag) {
+      case binary_log_sink::null_field:
+        out.emplace_back(key, "null");
+        break;
+      case binary_log_sink::bool_field:
+        out.emplace_back(key, src.read_int<uint8_t>() ? "true" : "false");
+        break;
+      case binary_log_sink::int_field:
+        out.emplace_back(key, std::to_string(src.read_int<int64_t>()));
+        break;
+      case binary_log_sink::uint_field:
+        out.emplace_back(key, std::to_string(src.read_int<uint64_t>()));
+        break;
+      case binary_log_sink::double_field:
+        out.emplace_back(key, std::to_string(detail::unpack754(
+                                src.read_int<uint64_t>())));
+        break;
+      case binary_log_sink::string_field: {
+        auto len = src.read_int<uint32_t>();
+        out.emplace_back(key, src.read_string(len));
+        break;
+      }
+      case binary_log_sink::list_field:
+        decode_fields(src, strs, out, key + ".");
+        break;
+      default:
+        CAF_RAISE_ERROR(std::logic_error, "invalid field tag");
+    }
+  }
+}
+
+decoded_segment decode(const std::string& path) {
+  detail::mapped_file file;
+  if (auto err = file.open_read_only(path); err.valid())
+    CAF_RAISE_ERROR(std::logic_error, "failed to open segment");
+  decoded_segment result;
+  auto bytes = file.bytes();
+  if (bytes.size() < binary_log_sink::header_size
+      || memcmp(bytes.data(), binary_log_sink::magic.data(), 8) != 0)
+    CAF_RAISE_ERROR(std::logic_error, "invalid segment header");
+  segment_reader src{bytes};
+  src.skip(8);
+  result.version = src.read_int<uint32_t>();
+  src.skip(4);
+  result.sequence = src.read_int<uint64_t>();
+  result.t0 = src.read_int<int64_t>();
+  std::map<uint32_t, std::string> strs;
+  while (!src.at_end()) {
+    auto size = src.read_int<uint32_t>();
+    if (size == 0)
+      break;
+    auto end = src.pos() + size;
+    auto type = src.read_int<uint8_t>();
+    switch (type) {
+      case binary_log_sink::string_record: {
+        auto id = src.read_int<uint32_t>();
+        strs[id] = src.read_string(end - src.pos());
+        break;
+      }
+      case binary_log_sink::level_record: {
+        auto level = src.read_int<uint32_t>();
+        result.levels[level] = src.read_string(end - src.pos());
+        break;
+      }
+      case binary_log_sink::event_record: {
+        auto& ev = result.events.emplace_back();
+        ev.timestamp = src.read_int<int64_t>();
+        ev.level = src.read_int<uint32_t>();
+        ev.component = strs[src.read_int<uint32_t>()];
+        ev.file = strs[src.read_int<uint32_t>()];
+        ev.function = strs[src.read_int<uint32_t>()];
+        ev.line = src.read_int<uint32_t>();
+        ev.actor = src.read_int<uint64_t>();
+        src.skip(8); // thread ID
+        ev.message = src.read_string(src.read_int<uint32_t>());
+        decode_fields(src, strs, ev.fields, "");
+        break;
+      }
+      default:
+        CAF_RAISE_ERROR(std::logic_error, "invalid record type");
+    }
+    if (src.pos() != end)
+      CAF_RAISE_ERROR(std::logic_error, "record size mismatch");
+  }
+  return result;
+}
+
+struct fixture {
+  fixture() {
+    namespace fs = std::filesystem;
+    auto name = "caf-binary-log-" + std::to_string(detail::get_process_id());
+    path = (fs::temp_directory_path() / name).string();
+  }
+
+  ~fixture() {
+    sink.close();
+    for (size_t i = 0; i < 4; ++i)
+      std::filesystem::remove(sink.segment_path(i));
+  }
+
+  log::event_ptr make_event(std::string_view msg, int value) {
+    mock_logger lg;
+    log::event_sender{&lg,
+                      log::level::debug,
+                      "caf.test",
+                      std::source_location::current(),
+                      42,
+                      "{}",
+                      msg}
+      .field("value", value)
+      .field("name", "{}-{}", "item", value)
+      .field("nested", [](auto& builder) { builder.field("flag", true); })
+      .send();
+    return lg.event;
+  }
+
+  std::string path;
+  binary_log_sink sink;
+  detail::log_level_map levels;
+};
+
+} // namespace
+
+WITH_FIXTURE(fixture) {
+
+TEST("the sink writes events as binary records") {
+  auto t0 = make_timestamp();
+  require(sink.open(path, 0, 1, t0, levels).empty());
+  auto ev1 = make_event("hello", 1);
+  auto ev2 = make_event("world", 2);
+  sink.write(*ev1);
+  sink.write(*ev2);
+  sink.close();
+  auto seg = decode(sink.segment_path(0));
+  check_eq(seg.version, binary_log_sink::version);
+  check_eq(seg.sequence, 0u);
+  check_eq(seg.t0, t0.time_since_epoch().count());
+  check_eq(seg.levels[log::level::debug], "DEBUG");
+  check_eq(seg.levels[log::level::trace], "TRACE");
+  require_eq(seg.events.size(), 2u);
+  const auto& ev = seg.events[1];
+  check_eq(ev.timestamp, ev2->timestamp().time_since_epoch().count());
+  check_eq(ev.level, log::level::debug);
+  check_eq(ev.component, "caf.test");
+  check_eq(ev.file, ev2->file_name());
+  check_eq(ev.function, ev2->function_name());
+  check_eq(ev.line, ev2->line_number());
+  check_eq(ev.actor, 42u);
+  check_eq(ev.message, "world");
+  using kvp = std::pair<std::string, std::string>;
+  check_eq(ev.fields, std::vector<kvp>{{"value", "2"},
+                                       {"name", "item-2"},
+                                       {"nested.flag", "true"}});
+}
+
+TEST("the sink rotates through a fixed number of segments") {
+  auto t0 = make_timestamp();
+  require(sink.open(path, 4096, 2, t0, levels).empty());
+  auto n = 0;
+  // Fill the first segment and let the sink wrap around to segment 0 again.
+  while (sink.sequence() < 2) {
+    auto ev = make_event("event", ++n);
+    sink.write(*ev);
+  }
+  auto ev = make_event("last", ++n);
+  sink.write(*ev);
+  sink.close();
+  auto seg0 = decode(sink.segment_path(0));
+  auto seg1 = decode(sink.segment_path(1));
+  check_eq(seg0.sequence, 2u);
+  check_eq(seg1.sequence, 1u);
+  require(!seg0.events.empty());
+  require(!seg1.events.empty());
+  // Each segment is self-contained, i.e., string IDs are valid per segment.
+  check_eq(seg0.events.front().component, "caf.test");
+  check_eq(seg1.events.front().component, "caf.test");
+  check_eq(seg0.events.back().message, "last");
+  check_eq(seg0.levels.size(), seg1.levels.size());
+  // Events in consecutive segments continue seamlessly.
+  check_eq(seg1.events.back().fields.front().second,
+           std::to_string(n - 1 - static_cast<int>(seg0.events.size()) + 1));
+}
+
+} // WITH_FIXTURE(fixture)
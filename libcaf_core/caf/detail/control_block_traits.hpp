@@ -35,6 +35,15 @@ public:
                                            - ControlBlock::allocation_size);
   }
 
+  /// Returns the number of bytes for a control block plus an object of type
+  /// `ManagedType`, rounded up to the alignment of the control block.
+  template <class ManagedType>
+  static constexpr size_t block_size() noexcept {
+    constexpr size_t size = ControlBlock::allocation_size + sizeof(ManagedType);
+    constexpr size_t align = ControlBlock::alignment;
+    return (size + align - 1) / align * align;
+  }
+
   template <class ManagedType>
   static void* allocate() {
     static_assert(std::is_base_of_v<managed_type, ManagedType>);
@@ -91,6 +91,20 @@ public:
     }
   }
 
+  void append(std::list<pointer> values) {
+    if (values.empty())
+      return;
+    bool do_notify = false;
+    {
+      std::unique_lock guard{mtx_};
+      do_notify = items_.empty();
+      items_.splice(items_.end(), values);
+    }
+    if (do_notify) {
+      cv_.notify_one();
+    }
+  }
+
   pointer try_take_tail() {
     std::unique_lock guard{mtx_};
     if (!items_.empty()) {
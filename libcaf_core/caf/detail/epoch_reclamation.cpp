@@ -0,0 +1,210 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/epoch_reclamation.hpp"
+
+#include "caf/config.hpp"
+#include "caf/detail/assert.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace caf::detail {
+
+namespace {
+
+/// Number of retired objects that triggers an attempt to reclaim memory.
+constexpr size_t reclaim_threshold = 64;
+
+/// Announces the epoch of a single thread.
+struct alignas(CAF_CACHE_LINE_SIZE) thread_record {
+  /// Stores the epoch at which the thread entered its critical section or 0 if
+  /// the thread currently does not access shared data.
+  std::atomic<uint64_t> epoch = 0;
+
+  /// Signals whether a thread currently owns this record.
+  std::atomic<bool> in_use = true;
+
+  /// Links all records of the domain.
+  thread_record* next = nullptr;
+};
+
+struct retired_object {
+  void* ptr;
+  void (*fn)(void*);
+  uint64_t epoch;
+};
+
+class domain {
+public:
+  static domain& instance() {
+    // Intentionally leaked: threads may release their records after static
+    // destruction began.
+    static auto* ptr = new domain;
+    return *ptr;
+  }
+
+  thread_record* acquire_record() {
+    for (auto* rec = head_.load(); rec != nullptr; rec = rec->next) {
+      auto expected = false;
+      if (!rec->in_use.load(std::memory_order_relaxed)
+          && rec->in_use.compare_exchange_strong(expected, true))
+        return rec;
+    }
+    auto* rec = new thread_record;
+    rec->next = head_.load();
+    while (!head_.compare_exchange_weak(rec->next, rec)) {
+      // nop
+    }
+    return rec;
+  }
+
+  void enter(thread_record* rec) noexcept {
+    // Re-check the global epoch after publishing ours. Otherwise, writers may
+    // advance the epoch twice in between and free objects we are about to
+    // read.
+    auto current = global_epoch_.load();
+    for (;;) {
+      rec->epoch.store(current);
+      auto next = global_epoch_.load();
+      if (next == current)
+        return;
+      current = next;
+    }
+  }
+
+  void leave(thread_record* rec) noexcept {
+    rec->epoch.store(0, std::memory_order_release);
+  }
+
+  void retire(void* ptr, void (*fn)(void*)) {
+    std::vector<retired_object> garbage;
+    {
+      std::lock_guard guard{mtx_};
+      retired_.push_back(retired_object{ptr, fn, global_epoch_.load()});
+      if (retired_.size() < reclaim_threshold)
+        return;
+      try_advance();
+      collect(garbage);
+    }
+    dispose(garbage);
+  }
+
+  void synchronize() {
+    std::vector<retired_object> garbage;
+    {
+      std::unique_lock guard{mtx_};
+      auto target = global_epoch_.load() + 2;
+      while (global_epoch_.load() < target) {
+        if (!try_advance()) {
+          guard.unlock();
+          std::this_thread::yield();
+          guard.lock();
+        }
+      }
+      collect(garbage);
+    }
+    dispose(garbage);
+  }
+
+  size_t pending() {
+    std::lock_guard guard{mtx_};
+    return retired_.size();
+  }
+
+private:
+  // Advances the global epoch if all active readers have observed it.
+  // @pre `mtx_` is locked.
+  bool try_advance() noexcept {
+    auto current = global_epoch_.load();
+    for (auto* rec = head_.load(); rec != nullptr; rec = rec->next) {
+      auto epoch = rec->epoch.load();
+      if (epoch != 0 && epoch != current)
+        return false;
+    }
+    global_epoch_.store(current + 1);
+    return true;
+  }
+
+  // Moves all objects that no reader may access anymore to `garbage`.
+  // @pre `mtx_` is locked.
+  void collect(std::vector<retired_object>& garbage) {
+    auto current = global_epoch_.load();
+    auto is_pending = [current](const retired_object& obj) {
+      return obj.epoch + 2 > current;
+    };
+    auto i = std::stable_partition(retired_.begin(), retired_.end(),
+                                   is_pending);
+    garbage.insert(garbage.end(), i, retired_.end());
+    retired_.erase(i, retired_.end());
+  }
+
+  // Calls the deleters without holding the lock, because they may retire
+  // further objects.
+  static void dispose(std::vector<retired_object>& garbage) {
+    for (auto& obj : garbage)
+      obj.fn(obj.ptr);
+  }
+
+  /// Stores the current epoch. Starts at 1, because 0 marks inactive readers.
+  std::atomic<uint64_t> global_epoch_ = 1;
+
+  /// Points to the first thread record.
+  std::atomic<thread_record*> head_ = nullptr;
+
+  /// Protects `retired_` and serializes advancing the global epoch.
+  std::mutex mtx_;
+
+  /// Stores objects that wait for their deleter.
+  std::vector<retired_object> retired_;
+};
+
+struct thread_state {
+  thread_record* record = nullptr;
+  size_t depth = 0;
+
+  ~thread_state() {
+    if (record != nullptr)
+      record->in_use.store(false, std::memory_order_release);
+  }
+};
+
+thread_local thread_state this_thread_state;
+
+} // namespace
+
+epoch_guard::epoch_guard() {
+  auto& st = this_thread_state;
+  if (st.depth++ > 0)
+    return;
+  auto& dom = domain::instance();
+  if (st.record == nullptr)
+    st.record = dom.acquire_record();
+  dom.enter(st.record);
+}
+
+epoch_guard::~epoch_guard() {
+  auto& st = this_thread_state;
+  CAF_ASSERT(st.depth > 0);
+  if (--st.depth == 0)
+    domain::instance().leave(st.record);
+}
+
+void epoch_retire(void* ptr, void (*fn)(void*)) {
+  domain::instance().retire(ptr, fn);
+}
+
+void epoch_synchronize() {
+  CAF_ASSERT(this_thread_state.depth == 0);
+  domain::instance().synchronize();
+}
+
+size_t epoch_pending_retirements() {
+  return domain::instance().pending();
+}
+
+} // namespace caf::detail
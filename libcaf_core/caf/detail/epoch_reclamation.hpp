@@ -0,0 +1,51 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Epoch-based memory reclamation (EBR) for data structures with lock-free
+// readers. Readers announce that they are accessing shared data by creating an
+// `epoch_guard`. Writers unlink objects from the shared data structure and then
+// hand them to `epoch_retire`, which defers calling the deleter until no reader
+// can possibly hold a pointer to the object anymore.
+//
+// The implementation keeps one record per thread. Entering and leaving a
+// critical section only touches the record of the calling thread, i.e., readers
+// never write to shared cache lines.
+
+namespace caf::detail {
+
+/// Marks the calling thread as reading shared data for the lifetime of the
+/// guard. Guards may nest.
+class CAF_CORE_EXPORT epoch_guard {
+public:
+  epoch_guard();
+
+  epoch_guard(const epoch_guard&) = delete;
+
+  epoch_guard& operator=(const epoch_guard&) = delete;
+
+  ~epoch_guard();
+};
+
+/// Schedules `fn(ptr)` for when no reader may access `ptr` anymore.
+/// @pre `ptr` is no longer reachable for readers that start afterwards.
+/// @note Calls deleters of previously retired objects if possible. Hence,
+///       callers must not hold locks that the deleters may try to acquire.
+CAF_CORE_EXPORT void epoch_retire(void* ptr, void (*fn)(void*));
+
+/// Blocks until all readers that were active at the time of the call have left
+/// their critical section and then calls all pending deleters.
+/// @pre The calling thread does not hold an `epoch_guard`.
+CAF_CORE_EXPORT void epoch_synchronize();
+
+/// Returns the number of retired objects that still wait for their deleter.
+CAF_CORE_EXPORT size_t epoch_pending_retirements();
+
+} // namespace caf::detail
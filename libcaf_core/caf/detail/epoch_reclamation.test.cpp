@@ -0,0 +1,62 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/epoch_reclamation.hpp"
+
+#include "caf/test/test.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace caf;
+
+namespace {
+
+void set_flag(void* ptr) {
+  static_cast<std::atomic<bool>*>(ptr)->store(true);
+}
+
+void nop(void*) {
+  // nop
+}
+
+} // namespace
+
+TEST("retired objects outlive readers that were active when retiring") {
+  std::atomic<bool> deleted = false;
+  std::atomic<bool> reader_active = false;
+  std::atomic<bool> reader_done = false;
+  std::thread reader{[&] {
+    detail::epoch_guard guard;
+    reader_active = true;
+    while (!reader_done)
+      std::this_thread::yield();
+  }};
+  while (!reader_active)
+    std::this_thread::yield();
+  detail::epoch_retire(&deleted, set_flag);
+  // Retiring more objects triggers attempts to reclaim memory. However, the
+  // reader blocks the epoch from advancing.
+  for (int i = 0; i < 200; ++i)
+    detail::epoch_retire(nullptr, nop);
+  check(!deleted);
+  reader_done = true;
+  reader.join();
+  detail::epoch_synchronize();
+  check(deleted);
+  check_eq(detail::epoch_pending_retirements(), 0u);
+}
+
+TEST("epoch guards may nest") {
+  std::atomic<bool> deleted = false;
+  {
+    detail::epoch_guard outer;
+    {
+      detail::epoch_guard inner;
+    }
+    detail::epoch_retire(&deleted, set_flag);
+  }
+  detail::epoch_synchronize();
+  check(deleted);
+}
@@ -9,6 +9,7 @@
 #include "caf/detail/parser/chars.hpp"
 #include "caf/detail/parser/read_bool.hpp"
 #include "caf/detail/parser/read_number.hpp"
+#include "caf/detail/swar.hpp"
 #include "caf/pec.hpp"
 
 #include <cstring>
@@ -351,9 +352,36 @@ void read_json_null_or_nan(ParserState& ps, Consumer consumer) {
 // shallow or in-situ copies. Otherwise, we use the scratch-space and decode the
 // string while parsing.
 
+// Tries to read a JSON string without escape sequences in one go. Leaves the
+// parser state untouched if the string requires the FSM.
+template <class ParserState, class Unescaper, class Consumer>
+bool read_json_string_fast_path(ParserState& ps, Unescaper& escaper,
+                                Consumer& consumer) {
+  if (ps.current() != '"')
+    return false;
+  auto first = std::to_address(ps.i) + 1;
+  auto last = std::to_address(ps.i) + (ps.e - ps.i);
+  // Stop at newlines and null bytes as well, because the FSM needs to track
+  // lines and treats null bytes as end of input.
+  auto pos = swar::find_first_of<'"', '\\', '\n', '\0'>(first, last);
+  if (pos == last || *pos != '"')
+    return false;
+  auto dist = pos - first;
+  assign_value(escaper, consumer, ps.i + 1, ps.i + 1 + dist, false);
+  ps.i += dist + 1;
+  ps.column += static_cast<int32_t>(dist + 1);
+  auto ch = ps.next();
+  while (ch != '\0' && strchr(whitespace_chars, ch) != nullptr)
+    ch = ps.next();
+  ps.code = ch == '\0' ? pec::success : pec::trailing_character;
+  return true;
+}
+
 template <class ParserState, class Unescaper, class Consumer>
 void read_json_string(ParserState& ps, unit_t, Unescaper escaper,
                       Consumer consumer) {
+  if (read_json_string_fast_path(ps, escaper, consumer))
+    return;
   using iterator_t = typename ParserState::iterator_type;
   auto code_point = uint16_t{0};
   auto assign_code_point = [&code_point](uint16_t x) { code_point = x; };
@@ -618,6 +646,15 @@ std::string_view realloc(std::string_view str, std::pmr::memory_resource* res) {
   return std::string_view{buf, str.size()};
 }
 
+std::string_view unescape(std::string_view str,
+                          std::pmr::memory_resource* res) {
+  std::pmr::polymorphic_allocator<char> alloc{res};
+  auto* buf = alloc.allocate(str.size());
+  auto new_size = parser::do_unescape(str.data(), str.data() + str.size(),
+                                      buf);
+  return std::string_view{buf, new_size};
+}
+
 std::string_view concat(std::initializer_list<std::string_view> xs,
                         std::pmr::memory_resource* res) {
   auto get_size = [](size_t x, std::string_view str) { return x + str.size(); };
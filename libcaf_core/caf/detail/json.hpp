@@ -77,6 +77,12 @@ inline std::string_view realloc(std::string_view str, const storage_ptr& ptr) {
   return realloc(str, &ptr->buf);
 }
 
+/// Decodes all escape sequences in the JSON string @p str and allocates the
+/// result at the buffer resource.
+/// @pre @p str is a valid JSON string without the surrounding quotes.
+CAF_CORE_EXPORT std::string_view unescape(std::string_view str,
+                                          std::pmr::memory_resource* res);
+
 /// Concatenates all strings and allocates a single new string for the result.
 CAF_CORE_EXPORT std::string_view
 concat(std::initializer_list<std::string_view> xs,
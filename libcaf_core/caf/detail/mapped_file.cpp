@@ -0,0 +1,244 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/mapped_file.hpp"
+
+#include "caf/sec.hpp"
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+#ifdef CAF_WINDOWS
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <sys/types.h>
+#  include <unistd.h>
+#endif
+
+namespace caf::detail {
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+mapped_file::mapped_file(mapped_file&& other) noexcept {
+  swap(other);
+}
+
+mapped_file& mapped_file::operator=(mapped_file&& other) noexcept {
+  if (this != &other) {
+    close();
+    swap(other);
+  }
+  return *this;
+}
+
+mapped_file::~mapped_file() {
+  close();
+}
+
+void mapped_file::swap(mapped_file& other) noexcept {
+  using std::swap;
+  swap(data_, other.data_);
+  swap(size_, other.size_);
+  swap(writable_, other.writable_);
+#ifdef CAF_WINDOWS
+  swap(file_handle_, other.file_handle_);
+  swap(mapping_handle_, other.mapping_handle_);
+#else
+  swap(fd_, other.fd_);
+#endif
+}
+
+#ifdef CAF_WINDOWS
+
+// -- Windows implementation ---------------------------------------------------
+
+namespace {
+
+error map_impl(const std::string& path, size_t size, bool writable,
+               HANDLE& file_handle, HANDLE& mapping_handle, std::byte*& data,
+               size_t& mapped_size) {
+  auto access = writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ;
+  auto disposition = writable ? OPEN_ALWAYS : OPEN_EXISTING;
+  file_handle = CreateFileA(path.c_str(), access, FILE_SHARE_READ, nullptr,
+                            disposition, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file_handle == INVALID_HANDLE_VALUE) {
+    file_handle = nullptr;
+    return make_error(sec::cannot_open_file, "failed to open file", path);
+  }
+  if (!writable) {
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file_handle, &file_size))
+      return make_error(sec::runtime_error, "failed to query file size", path);
+    size = static_cast<size_t>(file_size.QuadPart);
+  }
+  mapped_size = size;
+  if (size == 0) {
+    // Windows refuses to map empty files. Keep the handle open and report an
+    // empty mapping.
+    return none;
+  }
+  auto protect = writable ? PAGE_READWRITE : PAGE_READONLY;
+  auto size64 = static_cast<uint64_t>(size);
+  mapping_handle = CreateFileMappingA(file_handle, nullptr, protect,
+                                      static_cast<DWORD>(size64 >> 32),
+                                      static_cast<DWORD>(size64 & 0xFFFFFFFF),
+                                      nullptr);
+  if (mapping_handle == nullptr)
+    return make_error(sec::runtime_error, "failed to map file", path);
+  auto view_access = writable ? FILE_MAP_WRITE : FILE_MAP_READ;
+  auto* ptr = MapViewOfFile(mapping_handle, view_access, 0, 0, size);
+  if (ptr == nullptr)
+    return make_error(sec::runtime_error, "failed to map file", path);
+  data = static_cast<std::byte*>(ptr);
+  return none;
+}
+
+} // namespace
+
+error mapped_file::open(const std::string& path, size_t size) {
+  close();
+  HANDLE file_handle = nullptr;
+  HANDLE mapping_handle = nullptr;
+  auto err = map_impl(path, size, true, file_handle, mapping_handle, data_,
+                      size_);
+  file_handle_ = file_handle;
+  mapping_handle_ = mapping_handle;
+  writable_ = true;
+  if (err)
+    close();
+  return err;
+}
+
+error mapped_file::open_read_only(const std::string& path) {
+  close();
+  HANDLE file_handle = nullptr;
+  HANDLE mapping_handle = nullptr;
+  auto err = map_impl(path, 0, false, file_handle, mapping_handle, data_,
+                      size_);
+  file_handle_ = file_handle;
+  mapping_handle_ = mapping_handle;
+  writable_ = false;
+  if (err)
+    close();
+  return err;
+}
+
+void mapped_file::close(size_t final_size) {
+  if (data_ != nullptr) {
+    UnmapViewOfFile(data_);
+    data_ = nullptr;
+  }
+  if (mapping_handle_ != nullptr) {
+    CloseHandle(static_cast<HANDLE>(mapping_handle_));
+    mapping_handle_ = nullptr;
+  }
+  if (file_handle_ != nullptr) {
+    if (writable_ && final_size < size_) {
+      LARGE_INTEGER pos;
+      pos.QuadPart = static_cast<LONGLONG>(final_size);
+      auto hdl = static_cast<HANDLE>(file_handle_);
+      if (SetFilePointerEx(hdl, pos, nullptr, FILE_BEGIN))
+        SetEndOfFile(hdl);
+    }
+    CloseHandle(static_cast<HANDLE>(file_handle_));
+    file_handle_ = nullptr;
+  }
+  size_ = 0;
+  writable_ = false;
+}
+
+error mapped_file::sync(size_t offset, size_t len) {
+  if (data_ == nullptr || !writable_ || offset >= size_)
+    return none;
+  len = (std::min)(len, size_ - offset);
+  if (!FlushViewOfFile(data_ + offset, len)
+      || !FlushFileBuffers(static_cast<HANDLE>(file_handle_)))
+    return make_error(sec::runtime_error, "failed to sync mapped file");
+  return none;
+}
+
+#else // CAF_WINDOWS
+
+// -- POSIX implementation -----------------------------------------------------
+
+error mapped_file::open(const std::string& path, size_t size) {
+  close();
+  fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd_ < 0)
+    return make_error(sec::cannot_open_file, "failed to open file", path);
+  if (ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+    close();
+    return make_error(sec::runtime_error, "failed to resize file", path);
+  }
+  writable_ = true;
+  if (size == 0)
+    return none;
+  auto* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (ptr == MAP_FAILED) {
+    close();
+    return make_error(sec::runtime_error, "failed to map file", path);
+  }
+  data_ = static_cast<std::byte*>(ptr);
+  size_ = size;
+  return none;
+}
+
+error mapped_file::open_read_only(const std::string& path) {
+  close();
+  fd_ = ::open(path.c_str(), O_RDONLY);
+  if (fd_ < 0)
+    return make_error(sec::cannot_open_file, "failed to open file", path);
+  struct stat st;
+  if (fstat(fd_, &st) != 0) {
+    close();
+    return make_error(sec::runtime_error, "failed to query file size", path);
+  }
+  auto size = static_cast<size_t>(st.st_size);
+  if (size == 0)
+    return none;
+  auto* ptr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd_, 0);
+  if (ptr == MAP_FAILED) {
+    close();
+    return make_error(sec::runtime_error, "failed to map file", path);
+  }
+  data_ = static_cast<std::byte*>(ptr);
+  size_ = size;
+  return none;
+}
+
+void mapped_file::close(size_t final_size) {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+    data_ = nullptr;
+  }
+  if (fd_ >= 0) {
+    if (writable_ && final_size < size_)
+      std::ignore = ftruncate(fd_, static_cast<off_t>(final_size));
+    ::close(fd_);
+    fd_ = -1;
+  }
+  size_ = 0;
+  writable_ = false;
+}
+
+error mapped_file::sync(size_t offset, size_t len) {
+  if (data_ == nullptr || !writable_ || offset >= size_)
+    return none;
+  len = std::min(len, size_ - offset);
+  // msync requires a page-aligned start address.
+  static const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  auto aligned_offset = offset - (offset % page_size);
+  len += offset - aligned_offset;
+  if (msync(data_ + aligned_offset, len, MS_SYNC) != 0)
+    return make_error(sec::runtime_error, "failed to sync mapped file");
+  return none;
+}
+
+#endif // CAF_WINDOWS
+
+} // namespace caf::detail
@@ -0,0 +1,114 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/error.hpp"
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+namespace caf::detail {
+
+/// Maps a file on disk into the address space of the process.
+class CAF_CORE_EXPORT mapped_file {
+public:
+  // -- constructors, destructors, and assignment operators --------------------
+
+  mapped_file() noexcept = default;
+
+  mapped_file(mapped_file&& other) noexcept;
+
+  mapped_file& operator=(mapped_file&& other) noexcept;
+
+  mapped_file(const mapped_file&) = delete;
+
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  ~mapped_file();
+
+  // -- open and close ---------------------------------------------------------
+
+  /// Opens or creates the file at `path`, resizes it to `size` bytes and maps
+  /// its content for reading and writing. Bytes past the previous end of the
+  /// file read as zero.
+  error open(const std::string& path, size_t size);
+
+  /// Opens the existing file at `path` and maps its entire content for
+  /// reading.
+  error open_read_only(const std::string& path);
+
+  /// Unmaps the file and closes the handle. Shrinks the file to `final_size`
+  /// bytes unless `final_size` is greater than or equal to `size()`.
+  void close(size_t final_size);
+
+  /// Unmaps the file and closes the handle without resizing the file.
+  void close() {
+    close(size_);
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Checks whether this object currently maps a file.
+  [[nodiscard]] bool valid() const noexcept {
+    return data_ != nullptr;
+  }
+
+  /// Returns a pointer to the first byte of the mapped region.
+  [[nodiscard]] std::byte* data() noexcept {
+    return data_;
+  }
+
+  /// Returns a pointer to the first byte of the mapped region.
+  [[nodiscard]] const std::byte* data() const noexcept {
+    return data_;
+  }
+
+  /// Returns the size of the mapped region in bytes.
+  [[nodiscard]] size_t size() const noexcept {
+    return size_;
+  }
+
+  /// Returns the mapped region as a span.
+  [[nodiscard]] std::span<std::byte> bytes() noexcept {
+    return {data_, size_};
+  }
+
+  /// Returns the mapped region as a span.
+  [[nodiscard]] std::span<const std::byte> bytes() const noexcept {
+    return {data_, size_};
+  }
+
+  // -- synchronization --------------------------------------------------------
+
+  /// Flushes the bytes in range `[offset, offset + len)` to disk and blocks
+  /// until the operating system completed the write.
+  error sync(size_t offset, size_t len);
+
+  /// Flushes all bytes to disk.
+  error sync() {
+    return sync(0, size_);
+  }
+
+private:
+  void swap(mapped_file& other) noexcept;
+
+  std::byte* data_ = nullptr;
+
+  size_t size_ = 0;
+
+  bool writable_ = false;
+
+#ifdef CAF_WINDOWS
+  void* file_handle_ = nullptr;
+  void* mapping_handle_ = nullptr;
+#else
+  int fd_ = -1;
+#endif
+};
+
+} // namespace caf::detail
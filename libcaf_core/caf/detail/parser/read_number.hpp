@@ -10,12 +10,17 @@
 #include "caf/detail/parser/add_ascii.hpp"
 #include "caf/detail/parser/chars.hpp"
 #include "caf/detail/parser/read_floating_point.hpp"
+#include "caf/detail/parser/scan_number.hpp"
 #include "caf/detail/parser/sub_ascii.hpp"
 #include "caf/none.hpp"
 #include "caf/pec.hpp"
 
+#include <concepts>
 #include <cstdint>
+#include <iterator>
+#include <memory>
 #include <type_traits>
+#include <variant>
 
 CAF_PUSH_UNUSED_LABEL_WARNING
 
@@ -193,6 +198,47 @@ void read_positive_number(State& ps, Consumer& consumer, EnableFloat = {},
     apply_consumer(consumer, result, ps.code);
 }
 
+/// Checks whether `State` parses a contiguous range of characters.
+template <class State>
+concept contiguous_char_parser_state
+  = std::contiguous_iterator<typename State::iterator_type>
+    && std::same_as<std::iter_value_t<typename State::iterator_type>, char>
+    && std::same_as<decltype(State::e), typename State::iterator_type>;
+
+/// Tries to read a number from a contiguous input without going through the
+/// FSM. Leaves the parser state untouched if the input requires the FSM.
+/// @returns `true` if the fast path consumed the number, `false` otherwise.
+template <bool EnableFloat, class State, class Consumer>
+bool read_number_fast_path(State& ps, Consumer& consumer) {
+  if constexpr (contiguous_char_parser_state<State>) {
+    using iterator_type = typename State::iterator_type;
+    auto ch = ps.current();
+    if (ch != '-' && (ch < '0' || ch > '9'))
+      return false;
+    auto first = std::to_address(ps.i);
+    auto last = first + (ps.e - ps.i);
+    scanned_number result;
+    auto consumed = scan_number(first, last, EnableFloat, result);
+    if (consumed == 0)
+      return false;
+    // Numbers never contain newlines, so we can skip ahead without tracking
+    // lines. The last call to `next` checks the character after the number.
+    ps.i += static_cast<std::iter_difference_t<iterator_type>>(consumed - 1);
+    ps.column += static_cast<int32_t>(consumed - 1);
+    ps.next();
+    ps.code = ps.current() == '\0' ? pec::success : pec::trailing_character;
+    auto apply = [&](auto x) {
+      // Unreachable for doubles if floating point numbers are disabled.
+      if constexpr (EnableFloat || !std::is_same_v<decltype(x), double>)
+        apply_consumer(consumer, x, ps.code);
+    };
+    std::visit(apply, result);
+    return true;
+  } else {
+    return false;
+  }
+}
+
 /// Reads a number, i.e., on success produces an `int64_t`, an `uint64_t` or a
 /// `double`.
 template <class State, class Consumer, class EnableFloat = std::true_type,
@@ -200,6 +246,8 @@ template <class State, class Consumer, class EnableFloat = std::true_type,
 void read_number(State& ps, Consumer& consumer, EnableFloat fl_token = {},
                  EnableRange rng_token = {}) {
   constexpr bool enable_float = EnableFloat::value;
+  if (read_number_fast_path<enable_float>(ps, consumer))
+    return;
   using odbl = std::optional<double>;
   // clang-format off
   // Definition of our parser FSM.
@@ -0,0 +1,107 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/parser/scan_number.hpp"
+
+#include <charconv>
+#include <limits>
+#include <system_error>
+
+namespace caf::detail::parser {
+
+namespace {
+
+bool is_digit(char ch) noexcept {
+  return ch >= '0' && ch <= '9';
+}
+
+// Characters that would make the FSM continue reading the number, e.g., for
+// parsing hexadecimal numbers or ranges.
+bool continues_number(char ch) noexcept {
+  return is_digit(ch) || ch == '.' || (ch >= 'a' && ch <= 'z')
+         || (ch >= 'A' && ch <= 'Z');
+}
+
+} // namespace
+
+size_t scan_number(const char* first, const char* last, bool enable_float,
+                   scanned_number& result) noexcept {
+  auto i = first;
+  auto negative = i != last && *i == '-';
+  if (negative)
+    ++i;
+  if (i == last || !is_digit(*i))
+    return 0;
+  // Read the integer part, bailing out on overflows.
+  uint64_t value = 0;
+  auto overflow = false;
+  if (*i == '0') {
+    ++i;
+  } else {
+    constexpr auto max_value = std::numeric_limits<uint64_t>::max();
+    for (; i != last && is_digit(*i); ++i) {
+      auto digit = static_cast<uint64_t>(*i - '0');
+      if (value > (max_value - digit) / 10)
+        overflow = true;
+      value = value * 10 + digit;
+    }
+  }
+  auto is_float = false;
+  // Read the fraction.
+  if (i != last && *i == '.') {
+    if (i + 1 == last || !is_digit(i[1]))
+      return 0; // Let the FSM deal with ranges and trailing dots.
+    is_float = true;
+    i += 2;
+    while (i != last && is_digit(*i))
+      ++i;
+  }
+  // Read the exponent. The FSM reads "0e1" as octal 0 followed by "e1".
+  if (i != last && (*i == 'e' || *i == 'E')) {
+    if (!is_float && value == 0)
+      return 0;
+    auto j = i + 1;
+    if (j != last && (*j == '+' || *j == '-'))
+      ++j;
+    if (j == last || !is_digit(*j))
+      return 0;
+    is_float = true;
+    i = j + 1;
+    while (i != last && is_digit(*i))
+      ++i;
+  }
+  if (i != last && continues_number(*i))
+    return 0;
+  auto consumed = static_cast<size_t>(i - first);
+  if (!is_float) {
+    if (overflow)
+      return 0;
+    if (!negative) {
+      result = value;
+      return consumed;
+    }
+    constexpr auto min_abs = uint64_t{1} << 63;
+    if (value > min_abs)
+      return 0;
+    result = value == min_abs ? std::numeric_limits<int64_t>::min()
+                              : -static_cast<int64_t>(value);
+    return consumed;
+  }
+  if (!enable_float)
+    return 0;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  // Implementations of std::from_chars for floating point numbers use fast
+  // and correctly rounded algorithms such as Eisel-Lemire.
+  double dbl = 0;
+  auto [ptr, ec] = std::from_chars(first, i, dbl);
+  if (ec != std::errc{} || ptr != i)
+    return 0;
+  result = dbl;
+  return consumed;
+#else
+  return 0;
+#endif
+}
+
+} // namespace caf::detail::parser
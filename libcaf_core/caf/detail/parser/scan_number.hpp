@@ -0,0 +1,29 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <variant>
+
+namespace caf::detail::parser {
+
+/// Stores the result of `scan_number`.
+using scanned_number = std::variant<int64_t, uint64_t, double>;
+
+/// Scans a decimal number in the syntax `-?(0|[1-9][0-9]*)(\.[0-9]+)?
+/// ([eE][+-]?[0-9]+)?` at the beginning of `[first, last)` without going
+/// through the parser FSM. Negative integers produce an `int64_t`, positive
+/// integers an `uint64_t` and all other numbers a `double`.
+/// @returns the number of consumed characters or 0 if the input requires the
+///          generic parser, e.g., because it is out of range or uses a syntax
+///          not covered by this fast path such as hexadecimal notation.
+CAF_CORE_EXPORT size_t scan_number(const char* first, const char* last,
+                                   bool enable_float,
+                                   scanned_number& result) noexcept;
+
+} // namespace caf::detail::parser
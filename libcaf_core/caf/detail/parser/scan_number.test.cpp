@@ -0,0 +1,161 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/parser/scan_number.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/detail/parser/read_number.hpp"
+#include "caf/log/test.hpp"
+#include "caf/parser_state.hpp"
+#include "caf/pec.hpp"
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <string_view>
+#include <variant>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace tstlog = caf::log::test;
+
+namespace {
+
+using detail::parser::scan_number;
+using detail::parser::scanned_number;
+
+struct consumer {
+  std::variant<std::monostate, int64_t, uint64_t, double> x;
+
+  void value(int64_t y) {
+    x = y;
+  }
+
+  void value(uint64_t y) {
+    x = y;
+  }
+
+  void value(double y) {
+    x = y;
+  }
+};
+
+struct parse_result {
+  pec code;
+  size_t consumed;
+  std::variant<std::monostate, int64_t, uint64_t, double> x;
+};
+
+// Parses `str` with `read_number`, i.e., including the fast path.
+parse_result parse(std::string_view str) {
+  consumer f;
+  string_parser_state ps{str.begin(), str.end()};
+  detail::parser::read_number(ps, f);
+  return {ps.code, static_cast<size_t>(ps.i - str.begin()), f.x};
+}
+
+// Parses `str` by dispatching to the FSMs directly, bypassing the fast path.
+parse_result parse_reference(std::string_view str) {
+  consumer f;
+  string_parser_state ps{str.begin(), str.end()};
+  if (ps.current() == '-') {
+    ps.next();
+    detail::parser::read_negative_number(ps, f);
+  } else {
+    detail::parser::read_positive_number(ps, f);
+  }
+  return {ps.code, static_cast<size_t>(ps.i - str.begin()), f.x};
+}
+
+bool same_value(const parse_result& x, const parse_result& y) {
+  if (x.x.index() != y.x.index())
+    return false;
+  if (auto* dx = std::get_if<double>(&x.x)) {
+    // The FSM accumulates rounding errors, whereas the fast path rounds
+    // correctly. Hence, we only require both results to be close.
+    auto dy = std::get<double>(y.x);
+    return *dx == dy || std::abs(*dx - dy) <= std::abs(dy) * 1e-12;
+  }
+  return x.x == y.x;
+}
+
+} // namespace
+
+TEST("scan_number accepts decimal numbers") {
+  scanned_number x;
+  auto scan = [&x](std::string_view str) {
+    return scan_number(str.data(), str.data() + str.size(), true, x);
+  };
+  check_eq(scan("0"), 1u);
+  check(x == scanned_number{uint64_t{0}});
+  check_eq(scan("42,"), 2u);
+  check(x == scanned_number{uint64_t{42}});
+  check_eq(scan("-42]"), 3u);
+  check(x == scanned_number{int64_t{-42}});
+  check_eq(scan("18446744073709551615"), 20u);
+  check(x == scanned_number{UINT64_MAX});
+  check_eq(scan("-9223372036854775808"), 20u);
+  check(x == scanned_number{INT64_MIN});
+  check_eq(scan("1.5e3 "), 5u);
+  check(x == scanned_number{1.5e3});
+  check_eq(scan("-0.25"), 5u);
+  check(x == scanned_number{-0.25});
+}
+
+TEST("scan_number leaves special cases to the FSM") {
+  scanned_number x;
+  auto scan = [&x](std::string_view str) {
+    return scan_number(str.data(), str.data() + str.size(), true, x);
+  };
+  check_eq(scan("18446744073709551616"), 0u);
+  check_eq(scan("-9223372036854775809"), 0u);
+  check_eq(scan("0x10"), 0u);
+  check_eq(scan("0b10"), 0u);
+  check_eq(scan("017"), 0u);
+  check_eq(scan("1."), 0u);
+  check_eq(scan("1..3"), 0u);
+  check_eq(scan("0e1"), 0u);
+  check_eq(scan("1e"), 0u);
+  check_eq(scan("10ms"), 0u);
+  check_eq(scan("1e999"), 0u);
+  check_eq(scan_number("1.5", "1.5" + 3, false, x), 0u);
+}
+
+TEST("read_number produces the same results with and without fast path") {
+  // Hand-picked inputs plus a random corpus of number-like strings.
+  std::vector<std::string> corpus{
+    "0",       "1",          "-1",     "12,",        "-0",
+    "0.5",     "-0.5",       "1e10",   "1E-10",      "2.5e+3",
+    "007",     "0x1F",       "-0b101", "1.5.",       "1..2",
+    "3.14159", "1e308",      "1e-308", "123456789.", "-.5",
+    "99 ",     "1e5x",       "0.1]",   "-",          "1e+",
+    "42\n",    "4294967296", "0.0",    "-0.0e0",     "00",
+  };
+  std::minstd_rand rng{42};
+  constexpr auto alphabet = "0123456789-.eE+x, "sv;
+  std::uniform_int_distribution<size_t> len_dist{1, 24};
+  std::uniform_int_distribution<size_t> char_dist{0, alphabet.size() - 1};
+  std::uniform_int_distribution<int> digit_dist{0, 9};
+  for (int n = 0; n < 20'000; ++n) {
+    std::string str;
+    // Start with a digit or a minus sign to exercise the fast path.
+    str += n % 3 == 0 ? '-' : static_cast<char>('0' + digit_dist(rng));
+    auto len = len_dist(rng);
+    for (size_t i = 0; i < len; ++i)
+      str += n % 2 == 0 ? static_cast<char>('0' + digit_dist(rng))
+                        : alphabet[char_dist(rng)];
+    corpus.emplace_back(std::move(str));
+  }
+  for (const auto& str : corpus) {
+    auto res = parse(str);
+    auto ref = parse_reference(str);
+    auto ok = check_eq(res.code, ref.code);
+    if (ok && res.code <= pec::trailing_character)
+      ok = check_eq(res.consumed, ref.consumed) && check(same_value(res, ref));
+    if (!ok)
+      tstlog::error("mismatch for input {}", str);
+  }
+}
@@ -0,0 +1,161 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/size_based_credit_controller.hpp"
+
+#include "caf/binary_serializer.hpp"
+#include "caf/defaults.hpp"
+#include "caf/log/core.hpp"
+#include "caf/settings.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace caf::detail {
+
+namespace {
+
+template <class T>
+size_t positive_or(const settings& cfg, std::string_view key, T fallback) {
+  auto result = get_or(cfg, key, static_cast<int64_t>(fallback));
+  return result > 0 ? static_cast<size_t>(result)
+                    : static_cast<size_t>(fallback);
+}
+
+} // namespace
+
+size_based_credit_controller::config
+size_based_credit_controller::config::from(const settings& cfg) {
+  namespace sp = defaults::stream::size_policy;
+  config result;
+  result.bytes_per_batch = positive_or(
+    cfg, "caf.stream.size-policy.bytes-per-batch", sp::bytes_per_batch);
+  result.buffer_capacity = positive_or(
+    cfg, "caf.stream.size-policy.buffer-capacity", sp::buffer_capacity);
+  result.sampling_rate = positive_or(cfg, "caf.stream.size-policy.sampling-rate",
+                                     sp::sampling_rate);
+  result.calibration_interval
+    = positive_or(cfg, "caf.stream.size-policy.calibration-interval",
+                  sp::calibration_interval);
+  result.smoothing_factor
+    = get_or(cfg, "caf.stream.size-policy.smoothing-factor",
+             static_cast<double>(sp::smoothing_factor));
+  if (result.smoothing_factor <= 0 || result.smoothing_factor > 1)
+    result.smoothing_factor = sp::smoothing_factor;
+  result.latency_budget = get_or(cfg, "caf.stream.size-policy.latency-budget",
+                                 sp::latency_budget);
+  return result;
+}
+
+size_based_credit_controller::size_based_credit_controller(config cfg)
+  : cfg_(cfg) {
+  // nop
+}
+
+void size_based_credit_controller::init(size_t max_items_per_batch,
+                                        size_t max_in_flight_items,
+                                        size_t request_threshold_items,
+                                        time_point now) {
+  // Streams operate on batches, so we translate the user-defined bounds on
+  // per-item level to a rough equivalent on batches. Batches may be
+  // "under-full", so this isn't perfect in practice. The first calibration
+  // replaces these values with measured ones.
+  auto ipb = std::max(max_items_per_batch, size_t{1});
+  max_in_flight_batches_ = std::max(min_batch_buffering,
+                                    max_in_flight_items / ipb);
+  request_threshold_ = std::max(min_batch_request_threshold,
+                                request_threshold_items / ipb);
+  last_calibration_ = now;
+}
+
+bool size_based_credit_controller::on_batch(const async::batch& xs,
+                                            time_point now) {
+  ++received_batches_;
+  received_items_ += xs.size();
+  if (++batches_ % cfg_.sampling_rate != 0)
+    return false;
+  sample(xs);
+  if (++samples_ % cfg_.calibration_interval != 0)
+    return false;
+  calibrate(now);
+  return true;
+}
+
+void size_based_credit_controller::sample(const async::batch& xs) {
+  if (xs.size() == 0)
+    return;
+  buf_.clear();
+  binary_serializer sink{buf_};
+  auto tmp = xs;
+  if (!sink.apply(tmp)) {
+    log::core::debug("failed to serialize a sampled batch: {}",
+                     sink.get_error());
+    return;
+  }
+  sampled_bytes_ += buf_.size();
+  sampled_items_ += xs.size();
+}
+
+void size_based_credit_controller::calibrate(time_point now) {
+  // Update the moving averages.
+  if (sampled_items_ > 0) {
+    auto bpi = static_cast<double>(sampled_bytes_)
+               / static_cast<double>(sampled_items_);
+    bytes_per_item_ = smooth(bytes_per_item_, bpi);
+  }
+  if (received_batches_ > 0) {
+    auto ipb = static_cast<double>(received_items_)
+               / static_cast<double>(received_batches_);
+    items_per_batch_ = smooth(items_per_batch_, ipb);
+  }
+  auto elapsed = std::chrono::duration<double>{now - last_calibration_};
+  if (elapsed.count() > 0) {
+    auto ips = static_cast<double>(consumed_items_) / elapsed.count();
+    items_per_second_ = smooth(items_per_second_, ips);
+  }
+  sampled_bytes_ = 0;
+  sampled_items_ = 0;
+  received_batches_ = 0;
+  received_items_ = 0;
+  consumed_items_ = 0;
+  last_calibration_ = now;
+  if (bytes_per_item_ <= 0)
+    return;
+  // Compute how many batches fit into the memory budget.
+  auto items_per_batch = std::max(items_per_batch_, 1.0);
+  auto bytes_per_batch = std::max(bytes_per_item_ * items_per_batch, 1.0);
+  auto credit = static_cast<double>(cfg_.buffer_capacity) / bytes_per_batch;
+  // Restrict the credit further to what the consumer can process within the
+  // latency budget.
+  if (items_per_second_ > 0) {
+    auto budget = std::chrono::duration<double>{cfg_.latency_budget};
+    credit = std::min(credit,
+                      items_per_second_ * budget.count() / items_per_batch);
+  }
+  max_in_flight_batches_ = std::max(min_batch_buffering,
+                                    static_cast<size_t>(credit));
+  // Avoid sending demand messages that grant less than the desired batch size
+  // in Bytes, but never wait for more than half of the credit.
+  auto threshold = std::ceil(static_cast<double>(cfg_.bytes_per_batch)
+                             / bytes_per_batch);
+  request_threshold_ = std::clamp(static_cast<size_t>(threshold),
+                                  min_batch_request_threshold,
+                                  std::max(min_batch_request_threshold,
+                                           max_in_flight_batches_ / 2));
+  log::core::debug("calibrated stream credit: bytes_per_item = {}, "
+                   "items_per_second = {}, max_in_flight_batches = {}, "
+                   "request_threshold = {}",
+                   bytes_per_item_, items_per_second_, max_in_flight_batches_,
+                   request_threshold_);
+}
+
+double size_based_credit_controller::smooth(double old_value,
+                                            double new_value) const noexcept {
+  if (old_value <= 0)
+    return new_value;
+  auto alpha = cfg_.smoothing_factor;
+  return alpha * new_value + (1 - alpha) * old_value;
+}
+
+} // namespace caf::detail
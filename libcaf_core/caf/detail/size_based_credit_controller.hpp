@@ -0,0 +1,159 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/async/batch.hpp"
+#include "caf/byte_buffer.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+#include "caf/timespan.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace caf::detail {
+
+/// Computes the credit of an inbound stream at runtime. The controller samples
+/// how many Bytes stream items occupy in CAF's binary wire format and how fast
+/// the consumer processes items. Based on these measurements, it sizes the
+/// credit so that the buffered items stay within a memory budget and so that
+/// the consumer can drain all buffered items within a latency budget.
+class CAF_CORE_EXPORT size_based_credit_controller {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using time_point = std::chrono::steady_clock::time_point;
+
+  /// Configures the controller. The defaults are taken from
+  /// `caf::defaults::stream::size_policy`.
+  struct config {
+    /// Desired size of a single batch in Bytes.
+    size_t bytes_per_batch;
+
+    /// Number of Bytes the inbound path may buffer.
+    size_t buffer_capacity;
+
+    /// Computes the serialized size of every n-th batch.
+    size_t sampling_rate;
+
+    /// Re-calibrates the credit after this many samples.
+    size_t calibration_interval;
+
+    /// Degree of weighting decrease for older observations.
+    double smoothing_factor;
+
+    /// Maximum time that the consumer should need for draining the buffer.
+    timespan latency_budget;
+
+    /// Reads the config from the `caf.stream` section of `cfg`.
+    static config from(const settings& cfg);
+  };
+
+  // -- constants --------------------------------------------------------------
+
+  /// Configures how many (full) batches the bridge must be able to cache at
+  /// the very least.
+  static constexpr size_t min_batch_buffering = 5;
+
+  /// Configures how many batches we request in one go at the very least.
+  static constexpr size_t min_batch_request_threshold = 3;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit size_based_credit_controller(config cfg);
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the maximum number of batches that may be in flight.
+  size_t max_in_flight_batches() const noexcept {
+    return max_in_flight_batches_;
+  }
+
+  /// Returns the minimum number of batches to request at once.
+  size_t request_threshold() const noexcept {
+    return request_threshold_;
+  }
+
+  /// Returns the estimated serialized size of a single item.
+  double bytes_per_item() const noexcept {
+    return bytes_per_item_;
+  }
+
+  /// Returns the estimated number of items the consumer processes per second.
+  double items_per_second() const noexcept {
+    return items_per_second_;
+  }
+
+  // -- callbacks for the stream bridge ----------------------------------------
+
+  /// Initializes the credit from the bounds that the user passed to `observe`
+  /// and the batch size of the source.
+  void init(size_t max_items_per_batch, size_t max_in_flight_items,
+            size_t request_threshold_items, time_point now);
+
+  /// Updates the statistics for an incoming batch.
+  /// @returns `true` if the controller has re-calibrated the credit.
+  bool on_batch(const async::batch& xs, time_point now);
+
+  /// Updates the statistics after the consumer received `num_items`.
+  void on_consumed(size_t num_items) noexcept {
+    consumed_items_ += num_items;
+  }
+
+private:
+  void sample(const async::batch& xs);
+
+  void calibrate(time_point now);
+
+  double smooth(double old_value, double new_value) const noexcept;
+
+  config cfg_;
+
+  /// Credit in batches.
+  size_t max_in_flight_batches_ = min_batch_buffering;
+
+  /// Minimum number of batches per demand message.
+  size_t request_threshold_ = min_batch_request_threshold;
+
+  /// Counts received batches for picking samples.
+  size_t batches_ = 0;
+
+  /// Counts samples for triggering calibrations.
+  size_t samples_ = 0;
+
+  /// Accumulates the size of all sampled batches since the last calibration.
+  size_t sampled_bytes_ = 0;
+
+  /// Accumulates the number of items of all sampled batches since the last
+  /// calibration.
+  size_t sampled_items_ = 0;
+
+  /// Accumulates the number of received batches since the last calibration.
+  size_t received_batches_ = 0;
+
+  /// Accumulates the number of received items since the last calibration.
+  size_t received_items_ = 0;
+
+  /// Accumulates the number of consumed items since the last calibration.
+  size_t consumed_items_ = 0;
+
+  /// Moving average of the serialized size of an item.
+  double bytes_per_item_ = 0;
+
+  /// Moving average of the number of items per batch.
+  double items_per_batch_ = 0;
+
+  /// Moving average of the consumer rate.
+  double items_per_second_ = 0;
+
+  /// Stores when the last calibration took place.
+  time_point last_calibration_;
+
+  /// Buffer for serializing sampled batches.
+  byte_buffer buf_;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,114 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/size_based_credit_controller.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/async/batch.hpp"
+#include "caf/defaults.hpp"
+#include "caf/settings.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+using controller = detail::size_based_credit_controller;
+
+controller::config test_config() {
+  auto cfg = controller::config::from(settings{});
+  cfg.bytes_per_batch = 128;
+  cfg.buffer_capacity = 1024;
+  cfg.sampling_rate = 1;
+  cfg.calibration_interval = 2;
+  cfg.smoothing_factor = 1.0;
+  cfg.latency_budget = 1s;
+  return cfg;
+}
+
+async::batch make_int_batch(size_t size) {
+  std::vector<int32_t> xs(size);
+  std::iota(xs.begin(), xs.end(), 0);
+  return async::make_batch(xs);
+}
+
+} // namespace
+
+TEST("the config falls back to the defaults of the size policy") {
+  namespace sp = defaults::stream::size_policy;
+  auto cfg = controller::config::from(settings{});
+  check_eq(cfg.bytes_per_batch, static_cast<size_t>(sp::bytes_per_batch));
+  check_eq(cfg.buffer_capacity, static_cast<size_t>(sp::buffer_capacity));
+  check_eq(cfg.sampling_rate, static_cast<size_t>(sp::sampling_rate));
+  check_eq(cfg.calibration_interval,
+           static_cast<size_t>(sp::calibration_interval));
+  check_eq(cfg.latency_budget, sp::latency_budget);
+  SECTION("users may override the defaults") {
+    settings xs;
+    put(xs, "caf.stream.size-policy.buffer-capacity", 4096);
+    put(xs, "caf.stream.size-policy.latency-budget", timespan{5ms});
+    cfg = controller::config::from(xs);
+    check_eq(cfg.buffer_capacity, 4096u);
+    check_eq(cfg.latency_budget, timespan{5ms});
+  }
+}
+
+TEST("the initial credit depends on the user-defined bounds") {
+  auto uut = controller{test_config()};
+  auto t0 = controller::time_point{};
+  uut.init(10, 200, 50, t0);
+  check_eq(uut.max_in_flight_batches(), 20u);
+  check_eq(uut.request_threshold(), 5u);
+  SECTION("the credit is never less than the minimum") {
+    uut.init(10, 20, 10, t0);
+    check_eq(uut.max_in_flight_batches(), controller::min_batch_buffering);
+    check_eq(uut.request_threshold(), controller::min_batch_request_threshold);
+  }
+}
+
+TEST("calibrating limits the credit to the memory budget") {
+  auto uut = controller{test_config()};
+  auto t0 = controller::time_point{};
+  uut.init(8, 8, 8, t0);
+  // Pretend that the consumer is very fast.
+  uut.on_consumed(1'000'000);
+  check(!uut.on_batch(make_int_batch(8), t0 + 1s));
+  check(uut.on_batch(make_int_batch(8), t0 + 1s));
+  // Each item occupies at least four Bytes on the wire.
+  auto bpi = uut.bytes_per_item();
+  check_ge(bpi, 4.0);
+  check_le(bpi, 8.0);
+  auto expected = static_cast<size_t>(1024 / (bpi * 8));
+  check_eq(uut.max_in_flight_batches(), expected);
+  // Each demand message should grant at least 128 Bytes.
+  auto threshold = static_cast<size_t>(std::ceil(128 / (bpi * 8)));
+  check_eq(uut.request_threshold(),
+           std::max(threshold, controller::min_batch_request_threshold));
+}
+
+TEST("calibrating limits the credit to the latency budget") {
+  auto uut = controller{test_config()};
+  auto t0 = controller::time_point{};
+  uut.init(8, 8, 8, t0);
+  SECTION("a slow consumer receives the minimum credit") {
+    uut.on_consumed(16);
+    uut.on_batch(make_int_batch(8), t0 + 1s);
+    check(uut.on_batch(make_int_batch(8), t0 + 1s));
+    check_eq(uut.items_per_second(), 16.0);
+    check_eq(uut.max_in_flight_batches(), controller::min_batch_buffering);
+  }
+  SECTION("the credit grows with the rate of the consumer") {
+    uut.on_consumed(80);
+    uut.on_batch(make_int_batch(8), t0 + 1s);
+    check(uut.on_batch(make_int_batch(8), t0 + 1s));
+    check_eq(uut.items_per_second(), 80.0);
+    check_eq(uut.max_in_flight_batches(), 10u);
+  }
+}
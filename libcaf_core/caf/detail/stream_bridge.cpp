@@ -4,6 +4,8 @@
 
 #include "caf/detail/stream_bridge.hpp"
 
+#include "caf/actor_system_config.hpp"
+#include "caf/defaults.hpp"
 #include "caf/detail/assert.hpp"
 #include "caf/log/system.hpp"
 #include "caf/scheduled_actor.hpp"
@@ -13,14 +15,6 @@ namespace caf::detail {
 
 namespace {
 
-/// Configures how many (full) batches the bridge must be able to cache at the
-/// very least.
-constexpr size_t min_batch_buffering = 5;
-
-/// Configures how many batches we request in one go. This is to avoid sending
-/// one demand message for each batch we receive.
-constexpr size_t min_batch_request_threshold = 3;
-
 /// Sends an asynchronous, anonymous message to `receiver`without type checking.
 template <message_priority Priority = message_priority::normal, class Handle,
           class T, class... Ts>
@@ -52,14 +46,13 @@ void stream_bridge_sub::ack(uint64_t src_flow_id,
     do_abort(make_error(sec::protocol_error));
     return;
   }
-  // Update our state. Streams operate on batches, so we translate the
-  // user-defined bounds on per-item level to a rough equivalent on batches.
-  // Batches may be "under-full", so this isn't perfect in practice.
+  // Update our state. The controller translates the user-defined bounds on
+  // per-item level to a rough equivalent on batches.
   src_flow_id_ = src_flow_id;
-  max_in_flight_batches_ = std::max(min_batch_buffering,
-                                    max_in_flight_ / max_items_per_batch);
-  low_batches_threshold_ = std::max(min_batch_request_threshold,
-                                    request_threshold_ / max_items_per_batch);
+  ctrl_.init(max_items_per_batch, max_in_flight_, request_threshold_,
+             self_->steady_time());
+  max_in_flight_batches_ = ctrl_.max_in_flight_batches();
+  low_batches_threshold_ = ctrl_.request_threshold();
   // Go get some data.
   in_flight_batches_ = max_in_flight_batches_;
   unsafe_send_as(self_, src_,
@@ -99,12 +92,17 @@ void stream_bridge_sub::push(const async::batch& input) {
     do_abort(make_error(sec::protocol_error));
     return;
   }
-  // Push batch downstream or buffer it.
   --in_flight_batches_;
+  // Adjust the credit to the measured item size and consumer rate.
+  if (adaptive_ && ctrl_.on_batch(input, self_->steady_time())) {
+    max_in_flight_batches_ = ctrl_.max_in_flight_batches();
+    low_batches_threshold_ = ctrl_.request_threshold();
+  }
+  // Push batch downstream or buffer it.
   if (demand_ > 0) {
     CAF_ASSERT(buf_.empty());
     --demand_;
-    out_.on_next(input);
+    deliver(input);
     do_check_credit();
   } else {
     buf_.push_back(input);
@@ -115,7 +113,7 @@ void stream_bridge_sub::push() {
   auto lg = log::core::trace("");
   while (!buf_.empty() && demand_ > 0) {
     --demand_;
-    out_.on_next(buf_.front());
+    deliver(buf_.front());
     buf_.pop_front();
   }
   do_check_credit();
@@ -161,7 +159,11 @@ void stream_bridge_sub::do_abort(const error& reason) {
 }
 
 void stream_bridge_sub::do_check_credit() {
-  auto capacity = max_in_flight_batches_ - in_flight_batches_ - buf_.size();
+  // The controller may lower the credit while batches are still in flight.
+  auto used = in_flight_batches_ + buf_.size();
+  if (used >= max_in_flight_batches_)
+    return;
+  auto capacity = max_in_flight_batches_ - used;
   if (capacity >= low_batches_threshold_) {
     in_flight_batches_ += capacity;
     unsafe_send_as(self_, src_,
@@ -170,6 +172,11 @@ void stream_bridge_sub::do_check_credit() {
   }
 }
 
+void stream_bridge_sub::deliver(const async::batch& input) {
+  ctrl_.on_consumed(input.size());
+  out_.on_next(input);
+}
+
 stream_bridge::stream_bridge(scheduled_actor* self, strong_actor_ptr src,
                              uint64_t stream_id, size_t buf_capacity,
                              size_t request_threshold)
@@ -189,9 +196,12 @@ disposable stream_bridge::subscribe(flow::observer<async::batch> out) {
   auto local_id = self->new_u64_id();
   unsafe_send_as(
     self, src_, stream_open_msg{stream_id_, {self->ctrl(), add_ref}, local_id});
-  auto sub = make_counted<stream_bridge_sub>(self, std::move(src_), out,
-                                             local_id, buf_capacity_,
-                                             request_threshold_);
+  const auto& cfg = content(self->home_system().config());
+  auto policy = get_or(cfg, "caf.stream.credit-policy",
+                       defaults::stream::credit_policy);
+  auto sub = make_counted<stream_bridge_sub>(
+    self, std::move(src_), out, local_id, buf_capacity_, request_threshold_,
+    size_based_credit_controller::config::from(cfg), policy != "token-based");
   self->register_flow_state(local_id, sub);
   out.on_subscribe(flow::subscription{sub});
   return sub->as_disposable();
@@ -6,6 +6,7 @@
 
 #include "caf/actor_control_block.hpp"
 #include "caf/detail/atomic_ref_count.hpp"
+#include "caf/detail/size_based_credit_controller.hpp"
 #include "caf/flow/observer.hpp"
 #include "caf/flow/op/hot.hpp"
 #include "caf/flow/subscription.hpp"
@@ -20,13 +21,17 @@ class stream_bridge_sub : public flow::subscription::impl_base {
 public:
   stream_bridge_sub(scheduled_actor* self, strong_actor_ptr src,
                     flow::observer<async::batch> out, uint64_t snk_flow_id,
-                    size_t max_in_flight, size_t request_threshold)
+                    size_t max_in_flight, size_t request_threshold,
+                    size_based_credit_controller::config ctrl_cfg,
+                    bool adaptive)
     : self_(self),
       src_(std::move(src)),
       out_(std::move(out)),
       snk_flow_id_(snk_flow_id),
       max_in_flight_(max_in_flight),
-      request_threshold_(request_threshold) {
+      request_threshold_(request_threshold),
+      ctrl_(ctrl_cfg),
+      adaptive_(adaptive) {
     // nop
   }
 
@@ -65,6 +70,8 @@ private:
 
   void do_check_credit();
 
+  void deliver(const async::batch& input);
+
   mutable detail::atomic_ref_count ref_count_;
 
   scheduled_actor* self_;
@@ -84,6 +91,14 @@ private:
 
   size_t max_in_flight_;
   size_t request_threshold_;
+
+  /// Computes the credit for the source.
+  size_based_credit_controller ctrl_;
+
+  /// Stores whether the bridge re-calibrates the credit at runtime. Otherwise,
+  /// the credit remains at the initial values computed from the bounds that
+  /// the user passed to `observe`.
+  bool adaptive_;
 };
 
 using stream_bridge_sub_ptr = intrusive_ptr<stream_bridge_sub>;
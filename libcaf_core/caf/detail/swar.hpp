@@ -0,0 +1,57 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+// Portable "SIMD within a register" utilities for scanning text eight bytes at
+// a time. Used by the JSON parsers for skipping over string content.
+
+namespace caf::detail::swar {
+
+/// Returns a word with `x` in each byte.
+constexpr uint64_t broadcast(uint8_t x) noexcept {
+  return uint64_t{0x0101010101010101} * x;
+}
+
+/// Returns a word with the high bit set in each byte of `word` that equals
+/// `x`. Borrows may cause false positives in bytes that are more significant
+/// than a match, i.e., only the least significant match is reliable.
+constexpr uint64_t match(uint64_t word, uint8_t x) noexcept {
+  auto tmp = word ^ broadcast(x);
+  return (tmp - broadcast(0x01)) & ~tmp & broadcast(0x80);
+}
+
+/// Loads eight bytes starting at `ptr`.
+inline uint64_t load(const char* ptr) noexcept {
+  uint64_t result;
+  memcpy(&result, ptr, sizeof(result));
+  return result;
+}
+
+/// Returns a pointer to the first occurrence of any character in `Cs` in
+/// `[first, last)` or `last` if the range contains none of them.
+template <char... Cs>
+const char* find_first_of(const char* first, const char* last) noexcept {
+  static_assert(sizeof...(Cs) > 0);
+  // On little-endian machines, the least significant byte of a word is the
+  // first byte in memory. Hence, the first match is always reliable.
+  if constexpr (std::endian::native == std::endian::little) {
+    while (last - first >= 8) {
+      auto word = load(first);
+      auto mask = (match(word, static_cast<uint8_t>(Cs)) | ...);
+      if (mask != 0)
+        return first + std::countr_zero(mask) / 8;
+      first += 8;
+    }
+  }
+  while (first != last && ((*first != Cs) && ...))
+    ++first;
+  return first;
+}
+
+} // namespace caf::detail::swar
@@ -0,0 +1,58 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/swar.hpp"
+
+#include "caf/test/test.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+const char* find_reference(const char* first, const char* last) {
+  constexpr auto needles = "\"\\"sv;
+  return std::find_first_of(first, last, needles.begin(), needles.end());
+}
+
+} // namespace
+
+TEST("find_first_of returns the first match") {
+  auto find = [](std::string_view str) {
+    auto pos = detail::swar::find_first_of<'"', '\\'>(str.data(),
+                                                      str.data() + str.size());
+    return static_cast<size_t>(pos - str.data());
+  };
+  check_eq(find(""), 0u);
+  check_eq(find("abc"), 3u);
+  check_eq(find("\"abc"), 0u);
+  check_eq(find("abcdefg\""), 7u);
+  check_eq(find("abcdefgh\""), 8u);
+  check_eq(find("abcdefghijklmno\\\""), 15u);
+  // A match followed by characters that may cause false positives in higher
+  // bytes of the same word.
+  check_eq(find("ab\"!#\"\\c"), 2u);
+}
+
+TEST("find_first_of agrees with a scalar search") {
+  std::minstd_rand rng{42};
+  constexpr auto alphabet = "ab!#\"\\[]\x01\x7f\xff"sv;
+  std::uniform_int_distribution<size_t> len_dist{0, 40};
+  std::uniform_int_distribution<size_t> char_dist{0, alphabet.size() - 1};
+  for (int n = 0; n < 10'000; ++n) {
+    std::string str;
+    auto len = len_dist(rng);
+    for (size_t i = 0; i < len; ++i)
+      str += alphabet[char_dist(rng)];
+    auto first = str.data();
+    auto last = str.data() + str.size();
+    auto pos = detail::swar::find_first_of<'"', '\\'>(first, last);
+    check_eq(pos - first, find_reference(first, last) - first);
+  }
+}
@@ -17,6 +17,10 @@ observable_builder coordinator::make_observable() {
   return observable_builder{this};
 }
 
+bool coordinator::launch_worker(shared_callback_ptr<void(coordinator*)>) {
+  return false;
+}
+
 stream coordinator::to_stream_impl(cow_string,
                                    intrusive_ptr<flow::op::base<async::batch>>,
                                    type_id_t, size_t) {
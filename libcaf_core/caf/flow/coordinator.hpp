@@ -7,6 +7,7 @@
 #include "caf/action.hpp"
 #include "caf/async/execution_context.hpp"
 #include "caf/async/fwd.hpp"
+#include "caf/callback.hpp"
 #include "caf/cow_string.hpp"
 #include "caf/detail/core_export.hpp"
 #include "caf/flow/fwd.hpp"
@@ -138,6 +139,15 @@ public:
     return delay_for(rel_time, make_single_shot_action(std::forward<F>(what)));
   }
 
+  // -- workers ----------------------------------------------------------------
+
+  /// Launches a new coordinator that runs concurrently to this coordinator and
+  /// calls `init` on it from its own context. Operators such as `parallel_map`
+  /// use this function to distribute work.
+  /// @returns `true` if the coordinator launched a worker, `false` if this
+  ///          coordinator does not support launching workers.
+  virtual bool launch_worker(shared_callback_ptr<void(coordinator*)> init);
+
 private:
   virtual stream
   to_stream_impl(cow_string name,
@@ -27,17 +27,20 @@
 #include "caf/flow/op/fail.hpp"
 #include "caf/flow/op/from_resource.hpp"
 #include "caf/flow/op/from_steps.hpp"
+#include "caf/flow/op/group_by.hpp"
 #include "caf/flow/op/interval.hpp"
 #include "caf/flow/op/merge.hpp"
 #include "caf/flow/op/never.hpp"
 #include "caf/flow/op/on_backpressure_buffer.hpp"
 #include "caf/flow/op/on_error_resume_next.hpp"
+#include "caf/flow/op/parallel_map.hpp"
 #include "caf/flow/op/prefix_and_tail.hpp"
 #include "caf/flow/op/publish.hpp"
 #include "caf/flow/op/ref_count.hpp"
 #include "caf/flow/op/retry.hpp"
 #include "caf/flow/op/sample.hpp"
 #include "caf/flow/op/throttle_first.hpp"
+#include "caf/flow/op/window_reduce.hpp"
 #include "caf/flow/op/zip_with.hpp"
 #include "caf/flow/step/all.hpp"
 #include "caf/flow/subscription.hpp"
@@ -255,6 +258,42 @@ public:
     return materialize().buffer(count, period);
   }
 
+  /// @copydoc observable::window_reduce
+  template <class Acc, class Fold>
+  auto window_reduce(size_t count, Acc init, Fold fold) && {
+    return materialize().window_reduce(count, std::move(init),
+                                       std::move(fold));
+  }
+
+  /// @copydoc observable::window_reduce
+  template <class Acc, class Fold, class Merge>
+  auto window_reduce(size_t count, size_t step, Acc init, Fold fold,
+                     Merge merge) && {
+    return materialize().window_reduce(count, step, std::move(init),
+                                       std::move(fold), std::move(merge));
+  }
+
+  /// @copydoc observable::window_reduce
+  template <class Acc, class Fold>
+  auto window_reduce(timespan period, Acc init, Fold fold) && {
+    return materialize().window_reduce(period, std::move(init),
+                                       std::move(fold));
+  }
+
+  /// @copydoc observable::window_reduce
+  template <class Acc, class Fold, class Merge>
+  auto window_reduce(timespan length, timespan step, Acc init, Fold fold,
+                     Merge merge) && {
+    return materialize().window_reduce(length, step, std::move(init),
+                                       std::move(fold), std::move(merge));
+  }
+
+  /// @copydoc observable::session_reduce
+  template <class Acc, class Fold>
+  auto session_reduce(timespan gap, Acc init, Fold fold) && {
+    return materialize().session_reduce(gap, std::move(init), std::move(fold));
+  }
+
   /// @copydoc observable::cache
   auto cache() && {
     return materialize().cache();
@@ -449,6 +488,22 @@ public:
                                   std::move(inputs)...);
   }
 
+  /// @copydoc observable::parallel_map
+  template <class F>
+  auto parallel_map(size_t num_workers, F f,
+                    size_t max_in_flight = defaults::flow::buffer_size) && {
+    return materialize().parallel_map(num_workers, std::move(f),
+                                      max_in_flight);
+  }
+
+  /// @copydoc observable::ordered_parallel_map
+  template <class F>
+  auto ordered_parallel_map(size_t num_workers, F f,
+                            size_t window = defaults::flow::buffer_size) && {
+    return materialize().ordered_parallel_map(num_workers, std::move(f),
+                                              window);
+  }
+
   /// @copydoc observable::publish
   auto publish() && {
     return materialize().publish();
@@ -459,6 +514,21 @@ public:
     return materialize().share(subscriber_threshold);
   }
 
+  /// @copydoc observable::group_by
+  template <class KeyFn>
+  auto group_by(KeyFn key_fn,
+                size_t max_buffered = defaults::flow::buffer_size) && {
+    return materialize().group_by(std::move(key_fn), max_buffered);
+  }
+
+  /// @copydoc observable::group_by
+  template <class KeyFn>
+  auto group_by(KeyFn key_fn, timespan idle_timeout,
+                size_t max_buffered = defaults::flow::buffer_size) && {
+    return materialize().group_by(std::move(key_fn), idle_timeout,
+                                  max_buffered);
+  }
+
   /// @copydoc observable::prefix_and_tail
   observable<cow_tuple<cow_vector<output_type>, observable<output_type>>>
   prefix_and_tail(size_t prefix_size) && {
@@ -839,6 +909,71 @@ observable<cow_vector<T>> observable<T>::buffer(size_t count, timespan period) {
                              std::move(obs));
 }
 
+template <class T>
+template <class Acc, class Fold>
+observable<Acc> observable<T>::window_reduce(size_t count, Acc init,
+                                             Fold fold) {
+  using impl_t = op::window_reduce<T, Acc, Fold>;
+  auto spec = op::window_reduce_spec{};
+  spec.count = count;
+  return parent()->add_child_hdl(std::in_place_type<impl_t>, *this, spec,
+                                 std::move(init), std::move(fold));
+}
+
+template <class T>
+template <class Acc, class Fold, class Merge>
+observable<Acc> observable<T>::window_reduce(size_t count, size_t step,
+                                             Acc init, Fold fold,
+                                             Merge merge) {
+  using impl_t = op::window_reduce<T, Acc, Fold, Merge>;
+  auto spec = op::window_reduce_spec{};
+  spec.count = step;
+  spec.panes = step > 0 && count % step == 0 ? count / step : 0;
+  return parent()->add_child_hdl(std::in_place_type<impl_t>, *this, spec,
+                                 std::move(init), std::move(fold),
+                                 std::move(merge));
+}
+
+template <class T>
+template <class Acc, class Fold>
+observable<Acc> observable<T>::window_reduce(timespan period, Acc init,
+                                             Fold fold) {
+  using impl_t = op::window_reduce<T, Acc, Fold>;
+  auto spec = op::window_reduce_spec{};
+  spec.period = period;
+  return parent()->add_child_hdl(std::in_place_type<impl_t>, *this, spec,
+                                 std::move(init), std::move(fold));
+}
+
+template <class T>
+template <class Acc, class Fold, class Merge>
+observable<Acc> observable<T>::window_reduce(timespan length, timespan step,
+                                             Acc init, Fold fold,
+                                             Merge merge) {
+  using impl_t = op::window_reduce<T, Acc, Fold, Merge>;
+  auto spec = op::window_reduce_spec{};
+  spec.period = step;
+  if (step.count() > 0 && length.count() % step.count() == 0)
+    spec.panes = static_cast<size_t>(length.count() / step.count());
+  else
+    spec.panes = 0;
+  return parent()->add_child_hdl(std::in_place_type<impl_t>, *this, spec,
+                                 std::move(init), std::move(fold),
+                                 std::move(merge));
+}
+
+template <class T>
+template <class Acc, class Fold>
+observable<Acc> observable<T>::session_reduce(timespan gap, Acc init,
+                                              Fold fold) {
+  using impl_t = op::window_reduce<T, Acc, Fold>;
+  auto spec = op::window_reduce_spec{};
+  spec.period = gap;
+  spec.session = true;
+  return parent()->add_child_hdl(std::in_place_type<impl_t>, *this, spec,
+                                 std::move(init), std::move(fold));
+}
+
 template <class T>
 observable<T> observable<T>::cache() {
   using impl_t = op::cache<T>;
@@ -1071,8 +1206,53 @@ auto observable<T>::zip_with(F fn, T0 input0, Ts... inputs) {
   return observable<output_type>{};
 }
 
+template <class T>
+template <class F>
+auto observable<T>::parallel_map(size_t num_workers, F f,
+                                 size_t max_in_flight) {
+  using output_type = op::parallel_map_output_t<F, T>;
+  using impl_t = op::parallel_map<F, T>;
+  if (pimpl_)
+    return pimpl_->parent()->add_child_hdl(std::in_place_type<impl_t>, *this,
+                                           std::move(f), num_workers,
+                                           max_in_flight, false);
+  return observable<output_type>{};
+}
+
+template <class T>
+template <class F>
+auto observable<T>::ordered_parallel_map(size_t num_workers, F f,
+                                         size_t window) {
+  using output_type = op::parallel_map_output_t<F, T>;
+  using impl_t = op::parallel_map<F, T>;
+  if (pimpl_)
+    return pimpl_->parent()->add_child_hdl(std::in_place_type<impl_t>, *this,
+                                           std::move(f), num_workers, window,
+                                           true);
+  return observable<output_type>{};
+}
+
 // -- observable: splitting ----------------------------------------------------
 
+template <class T>
+template <class KeyFn>
+auto observable<T>::group_by(KeyFn key_fn, size_t max_buffered) {
+  return group_by(std::move(key_fn), timespan{0}, max_buffered);
+}
+
+template <class T>
+template <class KeyFn>
+auto observable<T>::group_by(KeyFn key_fn, timespan idle_timeout,
+                             size_t max_buffered) {
+  using impl_t = op::group_by<KeyFn, T>;
+  using output_type = typename impl_t::tuple_t;
+  if (pimpl_)
+    return pimpl_->parent()->add_child_hdl(std::in_place_type<impl_t>, *this,
+                                           std::move(key_fn), max_buffered,
+                                           idle_timeout);
+  return observable<output_type>{};
+}
+
 template <class T>
 observable<cow_tuple<cow_vector<T>, observable<T>>>
 observable<T>::prefix_and_tail(size_t n) {
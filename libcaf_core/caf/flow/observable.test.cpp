@@ -9,9 +9,13 @@
 #include "caf/test/scenario.hpp"
 #include "caf/test/test.hpp"
 
+#include "caf/async/spsc_buffer.hpp"
 #include "caf/error_code.hpp"
 #include "caf/flow/multicaster.hpp"
 
+#include <numeric>
+#include <vector>
+
 using caf::test::nil;
 using std::vector;
 
@@ -613,6 +617,33 @@ TEST("start_with(value) builds observable that emits value first") {
   }
 }
 
+SCENARIO("steps process batches from asynchronous buffers in one pass") {
+  GIVEN("an observable that reads from an SPSC buffer") {
+    WHEN("applying map and filter steps") {
+      THEN("the observer receives the results in batches") {
+        auto [pull, push] = async::make_spsc_buffer_resource<int>(64, 8);
+        auto xs = std::vector<int>(32);
+        std::iota(xs.begin(), xs.end(), 1);
+        auto snk = make_batch_observer<int>();
+        make_observable()
+          .from_resource(pull)
+          .map([](int x) { return x * 2; })
+          .filter([](int x) { return x % 4 == 0; })
+          .subscribe(snk->as_observer());
+        make_observable().from_container(xs).subscribe(push);
+        run_flows();
+        check(snk->completed());
+        auto expected = std::vector<int>{};
+        for (auto x : xs)
+          if (x % 2 == 0)
+            expected.push_back(x * 2);
+        check_eq(snk->buf, expected);
+        check_lt(snk->batch_sizes.size(), expected.size());
+      }
+    }
+  }
+}
+
 SCENARIO("auto_connect operators stay connected even without subscribers") {
   GIVEN("a connectable with an input observable") {
     auto src = caf::flow::multicaster<int>{coordinator()};
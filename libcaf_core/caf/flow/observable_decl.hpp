@@ -212,6 +212,56 @@ public:
   /// regular intervals .
   observable<cow_vector<T>> buffer(size_t count, timespan period);
 
+  /// Folds items into an accumulator per window of `count` items and emits
+  /// the accumulator whenever a window closes. Unlike `buffer`, this operator
+  /// never stores the items of a window.
+  /// @param count The number of items per window.
+  /// @param init The initial value of the accumulator for each window.
+  /// @param fold Either `void(Acc&, const T&)` to update the accumulator in
+  ///             place or `Acc(Acc, const T&)`.
+  template <class Acc, class Fold>
+  observable<Acc> window_reduce(size_t count, Acc init, Fold fold);
+
+  /// Folds items into an accumulator per sliding window of `count` items that
+  /// advances by `step` items. The operator keeps one accumulator per `step`
+  /// items and uses `merge` to combine them into the result for a window.
+  /// @param count The number of items per window.
+  /// @param step The number of items between two windows. Must divide
+  ///             `count`.
+  /// @param init The initial value of the accumulator for each window.
+  /// @param fold Folds an item into an accumulator.
+  /// @param merge Folds an accumulator into another accumulator.
+  template <class Acc, class Fold, class Merge>
+  observable<Acc>
+  window_reduce(size_t count, size_t step, Acc init, Fold fold, Merge merge);
+
+  /// Folds items into an accumulator per window of `period` and emits the
+  /// accumulator whenever a window closes, including empty windows.
+  /// @param period The length of each window.
+  /// @param init The initial value of the accumulator for each window.
+  /// @param fold Folds an item into an accumulator.
+  template <class Acc, class Fold>
+  observable<Acc> window_reduce(timespan period, Acc init, Fold fold);
+
+  /// Folds items into an accumulator per sliding window of `length` that
+  /// advances by `step`.
+  /// @param length The length of each window.
+  /// @param step The time between two windows. Must divide `length`.
+  /// @param init The initial value of the accumulator for each window.
+  /// @param fold Folds an item into an accumulator.
+  /// @param merge Folds an accumulator into another accumulator.
+  template <class Acc, class Fold, class Merge>
+  observable<Acc> window_reduce(timespan length, timespan step, Acc init,
+                                Fold fold, Merge merge);
+
+  /// Folds items into an accumulator per session, i.e., until this observable
+  /// produces no item for `gap`.
+  /// @param gap The minimum time without items that closes a session.
+  /// @param init The initial value of the accumulator for each session.
+  /// @param fold Folds an item into an accumulator.
+  template <class Acc, class Fold>
+  observable<Acc> session_reduce(timespan gap, Acc init, Fold fold);
+
   /// Caches the items emitted by the input observable and re-emits them to
   /// subscribers, essentially turning a hot input observable into a cold one.
   /// @note This operator uses an unbound buffer to cache items and should not
@@ -294,8 +344,59 @@ public:
   template <class F, class T0, class... Ts>
   auto zip_with(F fn, T0 input0, Ts... inputs);
 
+  /// Returns a transformation that applies `f` to each item on one of
+  /// `num_workers` concurrent workers. The observer receives the results in
+  /// the order in which the workers produce them.
+  /// @param num_workers The number of workers.
+  /// @param f The function to apply to each item. Each worker uses its own
+  ///          copy of `f`.
+  /// @param max_in_flight The maximum number of items that the operator has
+  ///                      requested from this observable but not yet emitted.
+  /// @note Requires a coordinator that is able to launch workers, e.g., an
+  ///       event-based actor.
+  template <class F>
+  auto parallel_map(size_t num_workers, F f,
+                    size_t max_in_flight = defaults::flow::buffer_size);
+
+  /// Like `parallel_map`, but the observer receives the results in the order
+  /// of their inputs. Results that arrive early wait in a reorder buffer.
+  /// @param num_workers The number of workers.
+  /// @param f The function to apply to each item. Each worker uses its own
+  ///          copy of `f`.
+  /// @param window The maximum number of items that the operator has
+  ///               requested from this observable but not yet emitted. Also
+  ///               the size of the reorder buffer.
+  template <class F>
+  auto ordered_parallel_map(size_t num_workers, F f,
+                            size_t window = defaults::flow::buffer_size);
+
   // -- splitting --------------------------------------------------------------
 
+  /// Splits this observable into groups by applying `key_fn` to each item. The
+  /// returned observable emits a tuple with the key and an observable for the
+  /// items of that group whenever it encounters a new key. Routing an item to
+  /// its group only requires a hash map lookup.
+  /// @param key_fn Returns the key for an item. The key type must be hashable.
+  /// @param max_buffered The maximum number of items that a group may buffer
+  ///                     before the operator stops requesting items from this
+  ///                     observable.
+  template <class KeyFn>
+  auto group_by(KeyFn key_fn,
+                size_t max_buffered = defaults::flow::buffer_size);
+
+  /// Like `group_by(key_fn, max_buffered)`, but completes groups that receive
+  /// no items for `idle_timeout`. A later item with the same key opens a new
+  /// group.
+  /// @param key_fn Returns the key for an item. The key type must be hashable.
+  /// @param idle_timeout The minimum time without items before the operator
+  ///                     completes a group.
+  /// @param max_buffered The maximum number of items that a group may buffer
+  ///                     before the operator stops requesting items from this
+  ///                     observable.
+  template <class KeyFn>
+  auto group_by(KeyFn key_fn, timespan idle_timeout,
+                size_t max_buffered = defaults::flow::buffer_size);
+
   /// Takes @p prefix_size elements from this observable and emits it in a tuple
   /// containing an observable for the remaining elements as the second value.
   /// The returned observable either emits a single element (the tuple) or none
@@ -23,6 +23,8 @@
 #include "caf/ref_counted.hpp"
 #include "caf/unit.hpp"
 
+#include <span>
+
 namespace caf::flow {
 
 /// Handle to a consumer of items.
@@ -40,6 +42,20 @@ public:
 
     virtual void on_next(const T& item) = 0;
 
+    /// Receives multiple items at once. Only called if `accepts_batches`
+    /// returns `true`.
+    /// @note Implementations must stop processing items after canceling their
+    ///       subscription.
+    virtual void on_next_batch(std::span<const T> items) {
+      for (const auto& item : items)
+        on_next(item);
+    }
+
+    /// Returns whether this observer overrides `on_next_batch`.
+    virtual bool accepts_batches() const noexcept {
+      return false;
+    }
+
     virtual void on_complete() = 0;
 
     virtual void on_error(const error& what) = 0;
@@ -129,6 +145,24 @@ public:
     pimpl_->on_next(item);
   }
 
+  /// Passes all `items` to the observer, using a single call to
+  /// `on_next_batch` if the observer accepts batches. Otherwise, calls
+  /// `on_next` for each item until this handle becomes invalid, e.g., because
+  /// the observer canceled its subscription.
+  /// @pre `valid()`
+  void on_next(std::span<const T> items) {
+    CAF_ASSERT(pimpl_ != nullptr);
+    if (pimpl_->accepts_batches()) {
+      pimpl_->on_next_batch(items);
+      return;
+    }
+    for (const auto& item : items) {
+      pimpl_->on_next(item);
+      if (!pimpl_)
+        return;
+    }
+  }
+
   bool valid() const noexcept {
     return pimpl_ != nullptr;
   }
@@ -249,6 +283,19 @@ public:
     sub_.request(1);
   }
 
+  void on_next_batch(std::span<const input_type> items) override {
+    for (const auto& item : items) {
+      on_next_(item);
+      if (!sub_)
+        return;
+    }
+    sub_.request(items.size());
+  }
+
+  bool accepts_batches() const noexcept override {
+    return true;
+  }
+
   void on_error(const error& what) override {
     if (sub_) {
       on_error_(what);
@@ -340,6 +387,16 @@ public:
       buf_->push(item);
   }
 
+  void on_next_batch(std::span<const value_type> items) override {
+    auto lg = log::core::trace("items = {}", items.size());
+    if (buf_)
+      buf_->push(items);
+  }
+
+  bool accepts_batches() const noexcept override {
+    return true;
+  }
+
   void on_complete() override {
     auto lg = log::core::trace("");
     if (buf_) {
@@ -11,9 +11,12 @@
 #include "caf/detail/type_list.hpp"
 #include "caf/flow/observer.hpp"
 
+#include <algorithm>
 #include <deque>
+#include <span>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace caf::flow::op {
 
@@ -104,6 +107,33 @@ public:
       do_run();
   }
 
+  void on_next_batch(std::span<const Input> items) override {
+    CAF_ASSERT(!in_ || in_flight_ >= items.size());
+    if (!in_)
+      return;
+    in_flight_ -= items.size();
+    // Run all items through the steps in a single loop. Since the steps are
+    // known at compile time, the compiler can inline the entire chain.
+    auto fn = [this, items](auto& step, auto&... steps) {
+      term_step term{this};
+      for (const auto& item : items)
+        if (!step.on_next(item, steps..., term))
+          return false;
+      return true;
+    };
+    if (!std::apply(fn, steps_)) {
+      in_.cancel();
+    } else {
+      pull();
+    }
+    if (!running_)
+      do_run();
+  }
+
+  bool accepts_batches() const noexcept override {
+    return true;
+  }
+
   void on_complete() override {
     if (!in_)
       return;
@@ -190,10 +220,17 @@ private:
     if (!out_)
       return;
     while (demand_ > 0 && !buf_.empty()) {
-      auto item = std::move(buf_.front());
-      buf_.pop_front();
-      --demand_;
-      out_.on_next(item);
+      // Move the items to a contiguous buffer to pass them to the observer in
+      // a single call. We can't pass a view into `buf_`, because the observer
+      // may cause our input to push more items while it runs.
+      auto n = std::min(demand_, buf_.size());
+      using std::make_move_iterator;
+      batch_.assign(make_move_iterator(buf_.begin()),
+                    make_move_iterator(buf_.begin() + n));
+      buf_.erase(buf_.begin(), buf_.begin() + n);
+      demand_ -= n;
+      out_.on_next(std::span<const output_type>{batch_});
+      batch_.clear();
       // Note: on_next() may call dispose() and set out_ to nullptr.
       if (!out_)
         return;
@@ -220,6 +257,7 @@ private:
   observer<output_type> out_;
   std::tuple<Steps...> steps_;
   std::deque<output_type> buf_;
+  std::vector<output_type> batch_;
   size_t demand_ = 0;
   size_t in_flight_ = 0;
   size_t max_buf_size_ = defaults::flow::buffer_size;
@@ -0,0 +1,419 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/cow_tuple.hpp"
+#include "caf/detail/assert.hpp"
+#include "caf/detail/atomic_ref_count.hpp"
+#include "caf/disposable.hpp"
+#include "caf/flow/coordinator.hpp"
+#include "caf/flow/observer.hpp"
+#include "caf/flow/op/cold.hpp"
+#include "caf/flow/op/ucast.hpp"
+#include "caf/flow/subscription.hpp"
+#include "caf/intrusive_ptr.hpp"
+#include "caf/timespan.hpp"
+
+#include <deque>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace caf::flow::op {
+
+template <class KeyFn, class T>
+using group_by_key_t = std::decay_t<std::invoke_result_t<KeyFn&, const T&>>;
+
+/// @relates group_by
+template <class KeyFn, class T>
+class group_by_sub : public subscription::impl_base,
+                     public observer_impl<T>,
+                     public ucast_sub_state_listener<T> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using key_type = group_by_key_t<KeyFn, T>;
+
+  using tuple_t = cow_tuple<key_type, observable<T>>;
+
+  using state_type = ucast_sub_state<T>;
+
+  struct group {
+    /// Pushes items to the subscriber of the group.
+    ucast_ptr<T> sink;
+
+    /// Stores whether the group received an item since the last sweep.
+    bool active = true;
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  group_by_sub(coordinator* parent, observer<tuple_t> out, KeyFn key_fn,
+               size_t max_buffered, timespan idle_timeout)
+    : parent_(parent),
+      out_(std::move(out)),
+      key_fn_(std::move(key_fn)),
+      max_buffered_(max_buffered),
+      idle_timeout_(idle_timeout) {
+    CAF_ASSERT(max_buffered_ > 0);
+  }
+
+  ~group_by_sub() override {
+    for (auto& [key, grp] : groups_) {
+      grp.sink->state().listener = nullptr;
+      grp.sink->close();
+    }
+  }
+
+  // -- implementation of observer ---------------------------------------------
+
+  coordinator* parent() const noexcept override {
+    return parent_;
+  }
+
+  void on_subscribe(flow::subscription sub) override {
+    if (!sub_ && !disposed()) {
+      sub_ = std::move(sub);
+      pull();
+    } else {
+      sub.cancel();
+    }
+  }
+
+  void on_next(const T& item) override {
+    if (!sub_)
+      return;
+    CAF_ASSERT(in_flight_ > 0);
+    --in_flight_;
+    // Preserve the order of items by queueing all items while waiting for
+    // demand to emit a new group.
+    if (!pending_.empty() || !route(item))
+      pending_.push_back(item);
+    pull();
+  }
+
+  void on_error(const error& reason) override {
+    if (!sub_)
+      return;
+    sub_.release_later();
+    pending_.clear();
+    for (auto& [key, grp] : groups_) {
+      grp.sink->state().listener = nullptr;
+      grp.sink->abort(reason);
+    }
+    groups_.clear();
+    saturated_.clear();
+    idle_timer_.dispose();
+    if (out_)
+      out_.on_error(reason);
+  }
+
+  void on_complete() override {
+    if (!sub_)
+      return;
+    sub_.release_later();
+    input_done_ = true;
+    if (pending_.empty())
+      fin();
+  }
+
+  // -- implementation of subscription -----------------------------------------
+
+  bool disposed() const noexcept override {
+    return !out_ && groups_.empty();
+  }
+
+  void request(size_t n) override {
+    demand_ += n;
+    // Emitting items from `request` is not allowed. Hence, we schedule an
+    // action if we have items that are waiting for a new group.
+    if (!pending_.empty() && !drain_scheduled_) {
+      drain_scheduled_ = true;
+      parent_->delay_fn([ptr = strong_this()] {
+        ptr->drain_scheduled_ = false;
+        ptr->drain();
+      });
+    }
+  }
+
+  // -- implementation of ucast_sub_state_listener -----------------------------
+
+  void on_disposed(state_type* state, bool) override {
+    // The subscriber of a group canceled. Items for this key start a new group.
+    parent_->delay_fn([ptr = strong_this(), state] {
+      ptr->drop_group(state);
+    });
+  }
+
+  void on_consumed_some(state_type* state, size_t old_buffer_size,
+                        size_t new_buffer_size) override {
+    if (old_buffer_size >= max_buffered_ && new_buffer_size < max_buffered_) {
+      saturated_.erase(state);
+      pull();
+    }
+  }
+
+  // -- reference counting -----------------------------------------------------
+
+  void ref() const noexcept final {
+    ref_count_.inc();
+  }
+
+  void deref() const noexcept final {
+    ref_count_.dec(this);
+  }
+
+private:
+  intrusive_ptr<group_by_sub> strong_this() {
+    return {this, add_ref};
+  }
+
+  // -- routing ----------------------------------------------------------------
+
+  /// Pushes `item` to its group. Creates a new group if necessary.
+  /// @returns `false` if `item` requires a new group but the observer has no
+  ///          demand, `true` otherwise.
+  bool route(const T& item) {
+    auto key = key_fn_(item);
+    if (auto i = groups_.find(key); i != groups_.end()) {
+      if (!i->second.sink->state().disposed) {
+        push_to(i->second, item);
+        return true;
+      }
+      // The subscriber canceled but `drop_group` did not run yet. A disposed
+      // group swallows all items, so we replace it right away.
+      saturated_.erase(&i->second.sink->state());
+      groups_.erase(i);
+    }
+    if (!out_) {
+      // Nobody listens for new groups anymore: drop the item.
+      return true;
+    }
+    if (demand_ == 0)
+      return false;
+    --demand_;
+    auto sink = parent_->add_child(std::in_place_type<ucast<T>>);
+    sink->state().listener = this;
+    auto& grp = groups_.emplace(key, group{sink}).first->second;
+    start_idle_timer();
+    push_to(grp, item);
+    out_.on_next(make_cow_tuple(std::move(key), observable<T>{sink}));
+    return true;
+  }
+
+  void push_to(group& grp, const T& item) {
+    grp.active = true;
+    auto& st = grp.sink->state();
+    if (!st.push(item) && st.buf.size() == max_buffered_)
+      saturated_.insert(&st);
+  }
+
+  // Routes pending items until we need more demand from the observer.
+  void drain() {
+    while (!pending_.empty() && route(pending_.front()))
+      pending_.pop_front();
+    if (!pending_.empty())
+      return;
+    if (input_done_)
+      fin();
+    else
+      pull();
+  }
+
+  // Requests more items from the input unless a group or the observer is
+  // falling behind. Since items may be in flight while a group reaches the
+  // limit, a group buffers at most `2 * max_buffered_` items.
+  void pull() {
+    if (!sub_ || !pending_.empty() || !saturated_.empty())
+      return;
+    if (!out_ && groups_.empty()) {
+      sub_.cancel();
+      return;
+    }
+    if (in_flight_ <= max_buffered_ / 2) {
+      auto n = max_buffered_ - in_flight_;
+      in_flight_ += n;
+      sub_.request(n);
+    }
+  }
+
+  // -- group management -------------------------------------------------------
+
+  void close_group(group& grp) {
+    auto& st = grp.sink->state();
+    saturated_.erase(&st);
+    st.listener = nullptr;
+    grp.sink->close();
+  }
+
+  void drop_group(state_type* state) {
+    for (auto i = groups_.begin(); i != groups_.end(); ++i) {
+      auto& st = i->second.sink->state();
+      if (&st == state) {
+        saturated_.erase(state);
+        groups_.erase(i);
+        if (groups_.empty())
+          idle_timer_.dispose();
+        pull();
+        return;
+      }
+    }
+  }
+
+  void start_idle_timer() {
+    if (idle_timeout_.count() <= 0 || idle_timer_.valid())
+      return;
+    idle_timer_ = parent_->delay_for_fn(idle_timeout_, [ptr = strong_this()] {
+      ptr->idle_timer_ = disposable{};
+      ptr->sweep();
+    });
+  }
+
+  // Completes all groups that received no items since the last sweep and
+  // have no buffered items left. Hence, an idle group completes after at
+  // least one and at most two idle timeouts.
+  void sweep() {
+    auto evicted = false;
+    for (auto i = groups_.begin(); i != groups_.end();) {
+      auto& grp = i->second;
+      if (grp.active || !grp.sink->state().buf.empty()) {
+        grp.active = false;
+        ++i;
+      } else {
+        close_group(grp);
+        i = groups_.erase(i);
+        evicted = true;
+      }
+    }
+    if (!groups_.empty())
+      start_idle_timer();
+    if (evicted)
+      pull();
+  }
+
+  void fin() {
+    for (auto& [key, grp] : groups_)
+      close_group(grp);
+    groups_.clear();
+    idle_timer_.dispose();
+    if (out_)
+      out_.on_complete();
+  }
+
+  // -- implementation of subscription::impl_base ------------------------------
+
+  void do_dispose(bool from_external) override {
+    if (!out_)
+      return;
+    // Existing groups remain active after the observer canceled. We only stop
+    // emitting new groups and drop items for new keys from now on.
+    pending_.clear();
+    if (from_external)
+      out_.on_error(make_error(sec::disposed));
+    else
+      out_.release_later();
+    if (groups_.empty())
+      sub_.cancel();
+    else
+      pull();
+  }
+
+  // -- member variables -------------------------------------------------------
+
+  mutable detail::atomic_ref_count ref_count_;
+
+  /// Our scheduling context.
+  coordinator* parent_;
+
+  /// The observer for the groups.
+  observer<tuple_t> out_;
+
+  /// Selects the group for an item.
+  KeyFn key_fn_;
+
+  /// Maps keys to their group.
+  std::unordered_map<key_type, group> groups_;
+
+  /// Stores items that wait for demand to emit a new group.
+  std::deque<T> pending_;
+
+  /// Pulls data from the decorated observable.
+  flow::subscription sub_;
+
+  /// Periodically completes idle groups.
+  disposable idle_timer_;
+
+  /// Stores how many items are currently in-flight.
+  size_t in_flight_ = 0;
+
+  /// Stores the demand of the observer.
+  size_t demand_ = 0;
+
+  /// Stores the groups with at least `max_buffered_` items in their buffer.
+  std::unordered_set<state_type*> saturated_;
+
+  /// Configures the maximum number of items that a group may buffer before
+  /// the operator stops requesting items from its input.
+  size_t max_buffered_;
+
+  /// Configures when to complete a group that receives no more items. A
+  /// non-positive value disables eviction.
+  timespan idle_timeout_;
+
+  /// Stores whether the input has completed.
+  bool input_done_ = false;
+
+  /// Stores whether we have scheduled a call to `drain`.
+  bool drain_scheduled_ = false;
+};
+
+/// Splits the items of an observable into groups by applying a function that
+/// returns the key for each item.
+template <class KeyFn, class T>
+class group_by
+  : public cold<cow_tuple<group_by_key_t<KeyFn, T>, observable<T>>> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using tuple_t = cow_tuple<group_by_key_t<KeyFn, T>, observable<T>>;
+
+  using super = cold<tuple_t>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  group_by(coordinator* parent, observable<T> decorated, KeyFn key_fn,
+           size_t max_buffered, timespan idle_timeout)
+    : super(parent),
+      decorated_(std::move(decorated)),
+      key_fn_(std::move(key_fn)),
+      max_buffered_(max_buffered),
+      idle_timeout_(idle_timeout) {
+    // nop
+  }
+
+  disposable subscribe(observer<tuple_t> out) override {
+    if (max_buffered_ == 0) {
+      return super::fail_subscription(
+        out, make_error(sec::invalid_argument,
+                        "group_by requires a positive buffer size"));
+    }
+    using impl_t = group_by_sub<KeyFn, T>;
+    auto ptr = super::parent_->add_child(std::in_place_type<impl_t>, out,
+                                         key_fn_, max_buffered_,
+                                         idle_timeout_);
+    out.on_subscribe(subscription{ptr});
+    decorated_.subscribe(observer<T>{ptr});
+    return ptr->as_disposable();
+  }
+
+private:
+  observable<T> decorated_;
+  KeyFn key_fn_;
+  size_t max_buffered_;
+  timespan idle_timeout_;
+};
+
+} // namespace caf::flow::op
@@ -0,0 +1,173 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/flow/op/group_by.hpp"
+
+#include "caf/test/caf_test_main.hpp"
+#include "caf/test/fixture/deterministic.hpp"
+#include "caf/test/fixture/flow.hpp"
+#include "caf/test/scenario.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/event_based_actor.hpp"
+#include "caf/flow/multicaster.hpp"
+#include "caf/flow/observable.hpp"
+#include "caf/log/test.hpp"
+
+#include <map>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+using ivec = std::vector<int>;
+
+struct fixture : test::fixture::deterministic, test::fixture::flow {
+  ivec iota_vec(int n) {
+    ivec result(static_cast<size_t>(n));
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+  }
+};
+
+} // namespace
+
+WITH_FIXTURE(fixture) {
+
+SCENARIO("group_by splits a flow by key") {
+  GIVEN("an observable with the numbers 0 to 99") {
+    WHEN("grouping the items by their remainder when dividing by 3") {
+      THEN("each group receives all items with that remainder") {
+        auto groups = std::map<int, ivec>{};
+        auto completed_groups = 0;
+        auto completed = false;
+        make_observable()
+          .from_container(iota_vec(100))
+          .group_by([](int x) { return x % 3; })
+          .do_on_complete([&completed] { completed = true; })
+          .for_each([&](const cow_tuple<int, caf::flow::observable<int>>& grp) {
+            auto key = get<0>(grp);
+            auto items = get<1>(grp);
+            items.do_on_complete([&completed_groups] { ++completed_groups; })
+              .for_each([&groups, key](int x) { groups[key].push_back(x); });
+          });
+        run_flows();
+        check(completed);
+        check_eq(completed_groups, 3);
+        require_eq(groups.size(), 3u);
+        for (auto& [key, items] : groups) {
+          check_eq(items.size(), key == 0 ? 34u : 33u);
+          for (size_t index = 0; index < items.size(); ++index)
+            check_eq(items[index], key + 3 * static_cast<int>(index));
+        }
+      }
+    }
+  }
+  GIVEN("an observable that fails") {
+    WHEN("grouping the items") {
+      THEN("the observer and all groups receive the error") {
+        auto group_errors = 0;
+        auto result = error{};
+        make_observable()
+          .from_container(iota_vec(10))
+          .concat(make_observable().fail<int>(sec::runtime_error))
+          .group_by([](int x) { return x % 2; })
+          .do_on_error([&result](const error& err) { result = err; })
+          .for_each([&](const cow_tuple<int, caf::flow::observable<int>>& grp) {
+            auto items = get<1>(grp);
+            items
+              .do_on_error([&group_errors](const error&) { ++group_errors; })
+              .for_each([](int) {});
+          });
+        run_flows();
+        check_eq(result, sec::runtime_error);
+        check_eq(group_errors, 2);
+      }
+    }
+  }
+}
+
+SCENARIO("group_by applies backpressure per group") {
+  GIVEN("a group without a subscriber") {
+    WHEN("the input produces items for that group") {
+      THEN("the operator stops requesting items from the input") {
+        auto requested = size_t{0};
+        auto snk = std::make_shared<std::vector<caf::flow::observable<int>>>();
+        make_observable()
+          .repeat(1)
+          .do_on_next([&requested](int) { ++requested; })
+          .group_by([](int x) { return x; }, 16)
+          .for_each([snk](const cow_tuple<int, caf::flow::observable<int>>& grp) {
+            snk->push_back(get<1>(grp));
+          });
+        run_flows();
+        check_eq(snk->size(), 1u);
+        check_le(requested, 32u);
+        log::test::debug("subscribing to the group releases the input");
+        auto received = size_t{0};
+        snk->front().take(100).for_each([&received](int) { ++received; });
+        run_flows();
+        check_eq(received, 100u);
+      }
+    }
+  }
+}
+
+SCENARIO("group_by completes idle groups") {
+  GIVEN("a group_by operator with an idle timeout of 1s") {
+    WHEN("a group receives no items for more than two timeouts") {
+      THEN("the group completes") {
+        auto pub = caf::flow::multicaster<int>{coordinator()};
+        auto completed = std::make_shared<std::map<int, bool>>();
+        auto groups = std::make_shared<int>(0);
+        sys.spawn([&pub, completed, groups](event_based_actor* self) {
+          pub.as_observable()
+            .observe_on(self)
+            .group_by([](int x) { return x % 2; }, 1s)
+            .for_each(
+              [completed, groups](const cow_tuple<int, caf::flow::observable<int>>&
+                                    grp) {
+                auto key = get<0>(grp);
+                ++*groups;
+                (*completed)[key] = false;
+                auto items = get<1>(grp);
+                items
+                  .do_on_complete([completed, key] { (*completed)[key] = true; })
+                  .for_each([](int) {});
+              });
+        });
+        dispatch_messages();
+        pub.push({1, 2});
+        run_flows();
+        dispatch_messages();
+        check_eq(*groups, 2);
+        log::test::debug("keep group 1 alive, let group 0 go idle");
+        for (int i = 0; i < 3; ++i) {
+          advance_time(1s);
+          pub.push(3);
+          run_flows();
+          dispatch_messages();
+        }
+        check((*completed)[0]);
+        check(!(*completed)[1]);
+        log::test::debug("a new item for key 0 starts a new group");
+        pub.push(4);
+        run_flows();
+        dispatch_messages();
+        check_eq(*groups, 3);
+        pub.close();
+        run_flows();
+        dispatch_messages();
+        check((*completed)[0]);
+        check((*completed)[1]);
+      }
+    }
+  }
+}
+
+} // WITH_FIXTURE(fixture)
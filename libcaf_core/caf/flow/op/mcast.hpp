@@ -18,6 +18,7 @@
 #include <deque>
 #include <memory>
 #include <numeric>
+#include <span>
 
 namespace caf::flow::op {
 
@@ -126,6 +127,16 @@ public:
                            });
   }
 
+  /// Pushes @p items to all subscribers.
+  /// @returns `true` if all observers consumed all items immediately without
+  ///          buffering them, `false` otherwise.
+  bool push(std::span<const T> items) {
+    return std::accumulate(states_.begin(), states_.end(), true,
+                           [items](bool res, const state_ptr_type& ptr) {
+                             return res & ptr->push(items);
+                           });
+  }
+
   CAF_DEPRECATED("use push instead")
   bool push_all(const T& item) {
     return push(item);
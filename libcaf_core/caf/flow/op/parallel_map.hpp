@@ -0,0 +1,507 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/async/spsc_buffer.hpp"
+#include "caf/callback.hpp"
+#include "caf/defaults.hpp"
+#include "caf/detail/assert.hpp"
+#include "caf/detail/atomic_ref_count.hpp"
+#include "caf/flow/coordinator.hpp"
+#include "caf/flow/observable_decl.hpp"
+#include "caf/flow/observer.hpp"
+#include "caf/flow/op/cold.hpp"
+#include "caf/flow/op/from_resource.hpp"
+#include "caf/flow/op/ucast.hpp"
+#include "caf/flow/subscription.hpp"
+#include "caf/sec.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace caf::flow::op {
+
+/// Wraps an item with its position in the input sequence.
+template <class T>
+struct sequenced {
+  uint64_t seq;
+  T value;
+};
+
+/// Tags events from the input of a `parallel_map_sub`.
+struct parallel_map_input {};
+
+template <class F, class T>
+using parallel_map_output_t = std::decay_t<std::invoke_result_t<F&, const T&>>;
+
+/// Distributes the items of its input to a set of worker coordinators, each
+/// running `fn` on its share of the items, and merges the results.
+///
+/// Items travel to and from the workers through SPSC buffers. The operator
+/// numbers all inputs and never keeps more than `window` items in the system
+/// at a time, i.e., items that it requested from its input but did not emit
+/// to its observer yet. Hence, a slow observer eventually stops the input and
+/// a slow worker eventually stops the observer. When preserving the order,
+/// the operator stores out-of-order results in a ring buffer of size `window`
+/// until all predecessors arrived.
+template <class F, class T>
+class parallel_map_sub
+  : public subscription::impl_base,
+    public ucast_sub_state_listener<sequenced<T>> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using input_type = T;
+
+  using output_type = parallel_map_output_t<F, T>;
+
+  using input_item = sequenced<input_type>;
+
+  using output_item = sequenced<output_type>;
+
+  using input_state = ucast_sub_state<input_item>;
+
+  struct lane {
+    /// Pushes items to the worker.
+    ucast_ptr<input_item> input;
+
+    /// Receives results from the worker.
+    subscription output;
+
+    /// Counts results since last requesting more from the worker.
+    size_t received = 0;
+
+    /// Stores whether the worker has completed its output.
+    bool done = false;
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  parallel_map_sub(coordinator* parent, F fn, size_t num_workers,
+                   size_t window, bool ordered)
+    : parent_(parent),
+      fn_(std::move(fn)),
+      num_workers_(num_workers),
+      window_(window),
+      ordered_(ordered) {
+    CAF_ASSERT(num_workers_ > 0);
+    CAF_ASSERT(window_ > 0);
+    if (ordered_)
+      ring_.resize(window_);
+  }
+
+  // -- initialization ---------------------------------------------------------
+
+  /// Launches the workers and subscribes to `input`. On error, the operator
+  /// leaves `out` untouched.
+  error start(observer<output_type> out, observable<input_type>& input) {
+    // Note: the forwarders may call `fwd_on_subscribe` immediately. Hence, we
+    // must set `out_` before subscribing to the workers.
+    out_ = std::move(out);
+    auto min_request_size = std::min(defaults::flow::min_demand, window_);
+    lanes_.reserve(num_workers_);
+    for (size_t index = 0; index < num_workers_; ++index) {
+      auto [in_pull, in_push]
+        = async::make_spsc_buffer_resource<input_item>(window_,
+                                                       min_request_size);
+      auto [out_pull, out_push]
+        = async::make_spsc_buffer_resource<output_item>(window_,
+                                                        min_request_size);
+      auto init = [fn = fn_, in_pull, out_push](coordinator* ctx) mutable {
+        run_worker(ctx, std::move(fn), std::move(in_pull),
+                   std::move(out_push));
+      };
+      if (!parent_->launch_worker(make_shared_type_erased_callback(init))) {
+        shutdown_lanes();
+        lanes_.clear();
+        out_ = observer<output_type>{};
+        return make_error(sec::unsupported_operation,
+                          "parallel_map requires a coordinator that is able "
+                          "to launch workers");
+      }
+      auto& ln = lanes_.emplace_back();
+      ln.input = parent_->add_child(std::in_place_type<ucast<input_item>>);
+      ln.input->state().listener = this;
+      observable<input_item>{ln.input}.subscribe(std::move(in_push));
+      using fwd_impl = forwarder<output_item, parallel_map_sub, size_t>;
+      auto fwd = parent_->add_child(std::in_place_type<fwd_impl>,
+                                    strong_this(), index);
+      auto src = parent_->add_child_hdl(
+        std::in_place_type<from_resource<output_item>>, std::move(out_pull));
+      src.subscribe(fwd->as_observer());
+    }
+    using fwd_impl = forwarder<input_type, parallel_map_sub,
+                               parallel_map_input>;
+    auto fwd = parent_->add_child(std::in_place_type<fwd_impl>, strong_this(),
+                                  parallel_map_input{});
+    input.subscribe(fwd->as_observer());
+    return {};
+  }
+
+  // -- implementation of subscription -----------------------------------------
+
+  coordinator* parent() const noexcept override {
+    return parent_;
+  }
+
+  bool disposed() const noexcept override {
+    return !out_;
+  }
+
+  void request(size_t n) override {
+    if (!out_)
+      return;
+    demand_ += n;
+    // Emitting items from `request` is not allowed. Hence, we schedule an
+    // action if we have results that are ready for emitting.
+    if (has_ready_item() && !push_scheduled_) {
+      push_scheduled_ = true;
+      parent_->delay_fn([ptr = strong_this()] {
+        ptr->push_scheduled_ = false;
+        ptr->push();
+      });
+    }
+  }
+
+  // -- callbacks for the forwarders -------------------------------------------
+
+  void fwd_on_subscribe(parallel_map_input, subscription sub) {
+    if (!out_ || in_sub_ || input_done_) {
+      sub.cancel();
+      return;
+    }
+    in_sub_ = std::move(sub);
+    request_inputs();
+  }
+
+  void fwd_on_next(parallel_map_input, const input_type& item) {
+    if (!out_)
+      return;
+    CAF_ASSERT(in_flight_ > 0);
+    --in_flight_;
+    // Prefer the worker with the highest demand. If no worker signaled demand,
+    // queue the item at the worker with the fewest items in its queue.
+    auto& ln = *std::ranges::max_element(lanes_, [](auto& x, auto& y) {
+      auto& lhs = x.input->state();
+      auto& rhs = y.input->state();
+      if (lhs.demand != rhs.demand)
+        return lhs.demand < rhs.demand;
+      return lhs.buf.size() > rhs.buf.size();
+    });
+    ln.input->push(input_item{next_input_++, item});
+  }
+
+  void fwd_on_complete(parallel_map_input) {
+    if (!out_)
+      return;
+    input_done_ = true;
+    in_sub_.release_later();
+    for (auto& ln : lanes_)
+      close_lane(ln);
+    if (at_end())
+      fin();
+  }
+
+  void fwd_on_error(parallel_map_input, const error& what) {
+    input_done_ = true;
+    in_sub_.release_later();
+    abort(what);
+  }
+
+  void fwd_on_subscribe(size_t index, subscription sub) {
+    auto& ln = lanes_[index];
+    if (!out_ || ln.output || ln.done) {
+      sub.cancel();
+      return;
+    }
+    sub.request(window_);
+    ln.output = std::move(sub);
+  }
+
+  void fwd_on_next(size_t index, const output_item& item) {
+    if (!out_)
+      return;
+    auto& ln = lanes_[index];
+    if (++ln.received >= request_batch_size() && ln.output) {
+      ln.output.request(ln.received);
+      ln.received = 0;
+    }
+    if (ordered_) {
+      CAF_ASSERT(item.seq >= next_output_);
+      CAF_ASSERT(item.seq - next_output_ < window_);
+      ring_[item.seq % window_].emplace(item.value);
+    } else {
+      ready_.push_back(item.value);
+    }
+    push();
+  }
+
+  void fwd_on_complete(size_t index) {
+    if (!out_)
+      return;
+    auto& ln = lanes_[index];
+    ln.done = true;
+    ln.output.release_later();
+    if (at_end())
+      fin();
+  }
+
+  void fwd_on_error(size_t index, const error& what) {
+    auto& ln = lanes_[index];
+    ln.done = true;
+    ln.output.release_later();
+    abort(what);
+  }
+
+  // -- implementation of ucast_sub_state_listener -----------------------------
+
+  void on_disposed(input_state*, bool) override {
+    // We reset the listener before closing or disposing a lane. Hence, this
+    // callback only runs if a worker cancels its input prematurely.
+    parent_->delay_fn([ptr = strong_this()] {
+      ptr->abort(make_error(sec::runtime_error,
+                            "parallel_map worker canceled its input"));
+    });
+  }
+
+  // -- reference counting -----------------------------------------------------
+
+  void ref() const noexcept final {
+    ref_count_.inc();
+  }
+
+  void deref() const noexcept final {
+    ref_count_.dec(this);
+  }
+
+private:
+  static void run_worker(coordinator* ctx, F fn,
+                         async::consumer_resource<input_item> pull,
+                         async::producer_resource<output_item> push) {
+    ctx
+      ->add_child_hdl(std::in_place_type<from_resource<input_item>>,
+                      std::move(pull))
+      .map([fn = std::move(fn)](const input_item& x) mutable {
+        return output_item{x.seq, fn(x.value)};
+      })
+      .subscribe(std::move(push));
+  }
+
+  intrusive_ptr<parallel_map_sub> strong_this() {
+    return {this, add_ref};
+  }
+
+  size_t request_batch_size() const noexcept {
+    return std::max(window_ / 4, size_t{1});
+  }
+
+  // Returns the number of items that we have requested from the input but did
+  // not emit yet.
+  size_t in_system() const noexcept {
+    return in_flight_ + static_cast<size_t>(next_input_ - next_output_);
+  }
+
+  void request_inputs() {
+    if (!in_sub_)
+      return;
+    auto used = in_system();
+    CAF_ASSERT(used <= window_);
+    if (auto n = window_ - used; n >= request_batch_size()) {
+      in_flight_ += n;
+      in_sub_.request(n);
+    }
+  }
+
+  bool has_ready_item() const noexcept {
+    if (ordered_)
+      return ring_[next_output_ % window_].has_value();
+    return !ready_.empty();
+  }
+
+  output_type pop_ready_item() {
+    if (ordered_) {
+      auto& slot = ring_[next_output_ % window_];
+      auto result = std::move(*slot);
+      slot.reset();
+      return result;
+    }
+    auto result = std::move(ready_.front());
+    ready_.pop_front();
+    return result;
+  }
+
+  void push() {
+    while (out_ && demand_ > 0 && has_ready_item()) {
+      auto item = pop_ready_item();
+      ++next_output_;
+      --demand_;
+      out_.on_next(item);
+    }
+    if (!out_) // on_next might call cancel()
+      return;
+    if (at_end())
+      fin();
+    else
+      request_inputs();
+  }
+
+  bool at_end() const noexcept {
+    return input_done_ && next_input_ == next_output_
+           && std::ranges::all_of(lanes_, [](auto& ln) { return ln.done; });
+  }
+
+  void close_lane(lane& ln) {
+    if (ln.input) {
+      ln.input->state().listener = nullptr;
+      ln.input->close();
+    }
+  }
+
+  void shutdown_lanes() {
+    for (auto& ln : lanes_) {
+      if (ln.input) {
+        ln.input->state().listener = nullptr;
+        ln.input->state().dispose();
+        ln.input = nullptr;
+      }
+      ln.output.cancel();
+    }
+    ready_.clear();
+    ring_.clear();
+  }
+
+  void abort(const error& reason) {
+    if (!out_)
+      return;
+    in_sub_.cancel();
+    shutdown_lanes();
+    out_.on_error(reason);
+  }
+
+  void fin() {
+    in_sub_.cancel();
+    shutdown_lanes();
+    out_.on_complete();
+  }
+
+  void do_dispose(bool from_external) override {
+    if (!out_)
+      return;
+    in_sub_.cancel();
+    shutdown_lanes();
+    if (from_external)
+      out_.on_error(make_error(sec::disposed));
+    else
+      out_.release_later();
+  }
+
+  mutable detail::atomic_ref_count ref_count_;
+
+  /// Stores the context (coordinator) that runs this flow.
+  coordinator* parent_;
+
+  /// Transforms inputs on the workers.
+  F fn_;
+
+  /// Configures how many workers the operator launches.
+  size_t num_workers_;
+
+  /// Configures the maximum number of items in the system.
+  size_t window_;
+
+  /// Configures whether the operator emits results in the input order.
+  bool ordered_;
+
+  /// Stores the state per worker.
+  std::vector<lane> lanes_;
+
+  /// Stores the subscription to the input.
+  subscription in_sub_;
+
+  /// Stores whether the input has completed.
+  bool input_done_ = false;
+
+  /// Stores how many items we have requested from the input but not received
+  /// yet.
+  size_t in_flight_ = 0;
+
+  /// Stores the sequence number for the next input.
+  uint64_t next_input_ = 0;
+
+  /// Stores the sequence number of the next output.
+  uint64_t next_output_ = 0;
+
+  /// Stores results in input order, indexed by their sequence number modulo
+  /// `window_`. Only used when preserving the order.
+  std::vector<std::optional<output_type>> ring_;
+
+  /// Stores results in the order of arrival. Only used when the order does
+  /// not matter.
+  std::deque<output_type> ready_;
+
+  /// Stores whether we have scheduled a call to `push`.
+  bool push_scheduled_ = false;
+
+  /// Stores the demand of the observer.
+  size_t demand_ = 0;
+
+  /// Stores a handle to the subscribed observer.
+  observer<output_type> out_;
+};
+
+template <class F, class T>
+class parallel_map : public cold<parallel_map_output_t<F, T>> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using output_type = parallel_map_output_t<F, T>;
+
+  using super = cold<output_type>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  parallel_map(coordinator* parent, observable<T> input, F fn,
+               size_t num_workers, size_t window, bool ordered)
+    : super(parent),
+      input_(std::move(input)),
+      fn_(std::move(fn)),
+      num_workers_(num_workers),
+      window_(window),
+      ordered_(ordered) {
+    // nop
+  }
+
+  // -- implementation of observable<T>::impl ----------------------------------
+
+  disposable subscribe(observer<output_type> out) override {
+    if (num_workers_ == 0 || window_ == 0) {
+      return super::fail_subscription(
+        out, make_error(sec::invalid_argument,
+                        "parallel_map requires at least one worker and a "
+                        "positive window size"));
+    }
+    using sub_t = parallel_map_sub<F, T>;
+    auto ptr = super::parent_->add_child(std::in_place_type<sub_t>, fn_,
+                                         num_workers_, window_, ordered_);
+    if (auto err = ptr->start(out, input_))
+      return super::fail_subscription(out, err);
+    out.on_subscribe(subscription{ptr});
+    return ptr->as_disposable();
+  }
+
+private:
+  observable<T> input_;
+  F fn_;
+  size_t num_workers_;
+  size_t window_;
+  bool ordered_;
+};
+
+} // namespace caf::flow::op
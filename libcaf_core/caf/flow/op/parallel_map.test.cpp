@@ -0,0 +1,158 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/flow/op/parallel_map.hpp"
+
+#include "caf/test/caf_test_main.hpp"
+#include "caf/test/fixture/deterministic.hpp"
+#include "caf/test/scenario.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/event_based_actor.hpp"
+#include "caf/flow/observable_builder.hpp"
+#include "caf/flow/scoped_coordinator.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+std::vector<int> iota_vec(int n) {
+  std::vector<int> result(static_cast<size_t>(n));
+  std::iota(result.begin(), result.end(), 0);
+  return result;
+}
+
+std::vector<std::string> to_strings(const std::vector<int>& xs) {
+  std::vector<std::string> result;
+  for (auto x : xs)
+    result.push_back(std::to_string(x));
+  return result;
+}
+
+} // namespace
+
+WITH_FIXTURE(test::fixture::deterministic) {
+
+SCENARIO("ordered_parallel_map emits results in input order") {
+  GIVEN("an observable with 1000 items") {
+    WHEN("mapping the items on four workers") {
+      THEN("the observer receives all results in order") {
+        auto inputs = iota_vec(1000);
+        auto outputs = std::vector<std::string>{};
+        auto completed = false;
+        auto [self, launch] = sys.spawn_inactive();
+        self->make_observable()
+          .from_container(inputs)
+          .ordered_parallel_map(4, [](int x) { return std::to_string(x); }, 16)
+          .do_on_complete([&completed] { completed = true; })
+          .for_each([&outputs](const std::string& x) {
+            outputs.emplace_back(x);
+          });
+        launch();
+        dispatch_messages();
+        check(completed);
+        check_eq(outputs, to_strings(inputs));
+      }
+    }
+  }
+  GIVEN("an empty observable") {
+    WHEN("mapping the items on two workers") {
+      THEN("the observer receives on_complete") {
+        auto completed = false;
+        auto [self, launch] = sys.spawn_inactive();
+        self->make_observable()
+          .empty<int>()
+          .ordered_parallel_map(2, [](int x) { return x; })
+          .do_on_complete([&completed] { completed = true; })
+          .for_each([this](int) { fail("unexpected item"); });
+        launch();
+        dispatch_messages();
+        check(completed);
+      }
+    }
+  }
+}
+
+SCENARIO("parallel_map emits all results") {
+  GIVEN("an observable with 500 items") {
+    WHEN("mapping the items on three workers") {
+      THEN("the observer receives all results") {
+        auto inputs = iota_vec(500);
+        auto outputs = std::vector<int>{};
+        auto [self, launch] = sys.spawn_inactive();
+        self->make_observable()
+          .from_container(inputs)
+          .parallel_map(3, [](int x) { return x * 2; }, 8)
+          .for_each([&outputs](int x) { outputs.emplace_back(x); });
+        launch();
+        dispatch_messages();
+        std::ranges::sort(outputs);
+        auto expected = inputs;
+        for (auto& x : expected)
+          x *= 2;
+        check_eq(outputs, expected);
+      }
+    }
+  }
+}
+
+SCENARIO("parallel_map forwards errors") {
+  GIVEN("an observable that fails after emitting some items") {
+    WHEN("mapping the items on two workers") {
+      THEN("the observer receives the error") {
+        auto result = error{};
+        auto outputs = std::vector<int>{};
+        auto [self, launch] = sys.spawn_inactive();
+        self->make_observable()
+          .from_container(iota_vec(10))
+          .concat(self->make_observable().fail<int>(sec::runtime_error))
+          .ordered_parallel_map(2, [](int x) { return x; })
+          .do_on_error([&result](const error& err) { result = err; })
+          .for_each([&outputs](int x) { outputs.emplace_back(x); });
+        launch();
+        dispatch_messages();
+        check_eq(result, sec::runtime_error);
+        check_le(outputs.size(), 10u);
+      }
+    }
+  }
+  GIVEN("zero workers") {
+    WHEN("subscribing to the parallel_map operator") {
+      THEN("the observer receives an invalid_argument error") {
+        auto result = error{};
+        auto [self, launch] = sys.spawn_inactive();
+        self->make_observable()
+          .from_container(iota_vec(10))
+          .parallel_map(0, [](int x) { return x; })
+          .do_on_error([&result](const error& err) { result = err; })
+          .for_each([this](int) { fail("unexpected item"); });
+        launch();
+        dispatch_messages();
+        check_eq(result, sec::invalid_argument);
+      }
+    }
+  }
+  GIVEN("a coordinator that cannot launch workers") {
+    WHEN("subscribing to the parallel_map operator") {
+      THEN("the observer receives an unsupported_operation error") {
+        auto result = error{};
+        auto ctx = flow::make_scoped_coordinator();
+        ctx->make_observable()
+          .from_container(iota_vec(10))
+          .parallel_map(2, [](int x) { return x; })
+          .do_on_error([&result](const error& err) { result = err; })
+          .for_each([this](int) { fail("unexpected item"); });
+        ctx->run();
+        check_eq(result, sec::unsupported_operation);
+      }
+    }
+  }
+}
+
+} // WITH_FIXTURE(test::fixture::deterministic)
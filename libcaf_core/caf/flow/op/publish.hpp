@@ -100,6 +100,19 @@ public:
     }
   }
 
+  void on_next_batch(std::span<const T> items) override {
+    in_flight_ -= items.size();
+    if (this->push(items) && in_ && this->has_observers()) {
+      // Same as in on_next: all observers consumed the items right away.
+      in_flight_ += items.size();
+      in_.request(items.size());
+    }
+  }
+
+  bool accepts_batches() const noexcept override {
+    return true;
+  }
+
   void on_complete() override {
     source_ = nullptr;
     this->close();
@@ -13,7 +13,9 @@
 #include "caf/flow/subscription.hpp"
 #include "caf/intrusive_ptr.hpp"
 
+#include <algorithm>
 #include <deque>
+#include <span>
 #include <tuple>
 #include <utility>
 
@@ -112,6 +114,27 @@ public:
     }
   }
 
+  /// Pushes multiple items at once, passing as many items as possible to the
+  /// observer in a single call and buffering the remainder.
+  /// @returns `true` if all items were consumed, `false` if at least one item
+  ///          was buffered.
+  [[nodiscard]] bool push(std::span<const T> items) {
+    while (!disposed && !items.empty()) {
+      if (demand == 0 || this->is_pulling()) {
+        buf.insert(buf.end(), items.begin(), items.end());
+        return false;
+      }
+      CAF_ASSERT(out);
+      CAF_ASSERT(buf.empty());
+      auto n = std::min(demand, items.size());
+      demand -= n;
+      out.on_next(items.first(n));
+      // Note: on_next may call dispose() or request more items.
+      items = items.subspan(n);
+    }
+    return true;
+  }
+
   void close() {
     if (!disposed) {
       closed = true;
@@ -326,6 +349,11 @@ public:
     std::ignore = state_->push(item);
   }
 
+  /// Pushes @p items to the subscriber or buffers them until subscribed.
+  void push(std::span<const T> items) {
+    std::ignore = state_->push(items);
+  }
+
   /// Closes the operator, eventually emitting on_complete on all observers.
   void close() {
     state_->close();
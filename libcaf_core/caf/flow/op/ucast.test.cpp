@@ -11,6 +11,9 @@
 
 #include "caf/config.hpp"
 
+#include <span>
+#include <vector>
+
 using namespace caf;
 
 namespace {
@@ -126,6 +129,62 @@ SCENARIO("ucast operators deliver pending items before raising errors") {
   }
 }
 
+SCENARIO("ucast operators pass spans of items to their observer at once") {
+  GIVEN("a ucast operator with an observer that accepts batches") {
+    WHEN("pushing a span of items") {
+      THEN("the observer receives all items in a single batch") {
+        auto snk = make_batch_observer<int>();
+        auto uut = make_ucast();
+        uut->subscribe(snk->as_observer());
+        auto xs = std::vector<int>{1, 2, 3, 4, 5};
+        uut->push(std::span<const int>{xs});
+        check_eq(snk->buf, xs);
+        check_eq(snk->batch_sizes, std::vector<size_t>{5});
+        uut->close();
+        run_flows();
+        check(snk->completed());
+      }
+    }
+  }
+  GIVEN("a ucast operator with an observer that has insufficient demand") {
+    WHEN("pushing a span of items") {
+      THEN("the operator buffers the items that exceed the demand") {
+        auto snk = make_passive_observer<int>();
+        auto uut = make_ucast();
+        uut->subscribe(snk->as_observer());
+        snk->request(3);
+        run_flows();
+        auto xs = std::vector<int>{1, 2, 3, 4, 5};
+        uut->push(std::span<const int>{xs});
+        check_eq(snk->buf, std::vector<int>({1, 2, 3}));
+        check_eq(uut->buffered(), 2u);
+        snk->request(5);
+        run_flows();
+        check_eq(snk->buf, xs);
+        uut->close();
+        run_flows();
+        check(snk->completed());
+      }
+    }
+  }
+  GIVEN("a ucast operator with an observer that does not accept batches") {
+    WHEN("the observer disposes its subscription in on_next") {
+      THEN("no further items of the span arrive") {
+        using snk_t = flow::canceling_observer<int>;
+        auto snk = coordinator()->add_child(std::in_place_type<snk_t>, true);
+        auto uut = make_ucast();
+        auto sub = uut->subscribe(snk->as_observer());
+        auto xs = std::vector<int>{1, 2, 3};
+        uut->push(std::span<const int>{xs});
+        check(sub.disposed());
+        check_eq(snk->on_next_calls, 1);
+        uut->close();
+        run_flows();
+      }
+    }
+  }
+}
+
 #ifdef CAF_ENABLE_RTTI
 SCENARIO("requesting from disposed ucast operators is a no-op") {
   GIVEN("a ucast operator with a disposed subscription") {
@@ -0,0 +1,392 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/defaults.hpp"
+#include "caf/detail/assert.hpp"
+#include "caf/detail/atomic_ref_count.hpp"
+#include "caf/disposable.hpp"
+#include "caf/flow/coordinator.hpp"
+#include "caf/flow/observable_decl.hpp"
+#include "caf/flow/observer.hpp"
+#include "caf/flow/op/cold.hpp"
+#include "caf/flow/subscription.hpp"
+#include "caf/sec.hpp"
+#include "caf/timespan.hpp"
+#include "caf/unit.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace caf::flow::op {
+
+/// Configures the windows of a `window_reduce` operator. A window consists of
+/// `panes` consecutive panes and the operator emits a result whenever a pane
+/// closes. Hence, a window with a single pane is a tumbling window and a
+/// window with multiple panes is a sliding window that advances by one pane at
+/// a time.
+struct window_reduce_spec {
+  /// Closes a pane after receiving this many items. Zero for time-based panes.
+  size_t count = 0;
+
+  /// Closes a pane after this amount of time. For session windows, closes the
+  /// window after receiving no items for this amount of time.
+  timespan period{0};
+
+  /// Number of panes per window.
+  size_t panes = 1;
+
+  /// Selects session windows.
+  bool session = false;
+
+  /// Checks whether the spec describes a valid window.
+  bool valid() const noexcept {
+    if (panes == 0)
+      return false;
+    if (session)
+      return count == 0 && panes == 1 && period.count() > 0;
+    return (count > 0) != (period.count() > 0);
+  }
+};
+
+/// Folds `x` into `acc`. Accepts both in-place folds (`void(Acc&, const X&)`)
+/// and functional folds (`Acc(Acc, const X&)`).
+template <class F, class Acc, class X>
+void window_reduce_fold(F& fn, Acc& acc, const X& x) {
+  if constexpr (std::is_invocable_v<F&, Acc&, const X&>
+                && std::is_void_v<std::invoke_result_t<F&, Acc&, const X&>>)
+    fn(acc, x);
+  else
+    acc = fn(std::move(acc), x);
+}
+
+/// @relates window_reduce
+template <class T, class Acc, class Fold, class Merge>
+class window_reduce_sub : public subscription::impl_base,
+                          public observer_impl<T> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using steady_time_point = coordinator::steady_time_point;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  window_reduce_sub(coordinator* parent, observer<Acc> out,
+                    window_reduce_spec spec, Acc init, Fold fold, Merge merge)
+    : parent_(parent),
+      out_(std::move(out)),
+      spec_(spec),
+      init_(std::move(init)),
+      fold_(std::move(fold)),
+      merge_(std::move(merge)) {
+    CAF_ASSERT(spec_.valid());
+    panes_.resize(spec_.panes, init_);
+  }
+
+  // -- initialization ---------------------------------------------------------
+
+  /// Starts the timer for time-based windows.
+  void init() {
+    if (spec_.count == 0 && !spec_.session) {
+      next_tick_ = parent_->steady_time() + spec_.period;
+      start_timer(next_tick_);
+    }
+  }
+
+  // -- implementation of observer ---------------------------------------------
+
+  coordinator* parent() const noexcept override {
+    return parent_;
+  }
+
+  void on_subscribe(flow::subscription sub) override {
+    if (!sub_ && out_) {
+      sub_ = std::move(sub);
+      pull();
+    } else {
+      sub.cancel();
+    }
+  }
+
+  void on_next(const T& item) override {
+    if (!out_)
+      return;
+    CAF_ASSERT(in_flight_ > 0);
+    --in_flight_;
+    window_reduce_fold(fold_, panes_[index_], item);
+    ++pane_items_;
+    if (spec_.session) {
+      last_item_ = parent_->steady_time();
+      if (!timer_.valid())
+        start_timer(last_item_ + spec_.period);
+    } else if (pane_items_ == spec_.count) {
+      close_pane();
+    }
+    pull();
+  }
+
+  void on_error(const error& reason) override {
+    if (!out_)
+      return;
+    sub_.release_later();
+    timer_.dispose();
+    out_.on_error(reason);
+  }
+
+  void on_complete() override {
+    if (!out_)
+      return;
+    sub_.release_later();
+    timer_.dispose();
+    input_done_ = true;
+    // Emit a final result for a partially filled pane.
+    if (pane_items_ > 0 && !pending_)
+      close_pane();
+    if (!pending_)
+      out_.on_complete();
+  }
+
+  // -- implementation of subscription -----------------------------------------
+
+  bool disposed() const noexcept override {
+    return !out_;
+  }
+
+  void request(size_t n) override {
+    demand_ += n;
+    // Emitting items from `request` is not allowed. Hence, we schedule an
+    // action if we have a pending result.
+    if (pending_ && demand_ == n) {
+      parent_->delay_fn([ptr = strong_this()] { ptr->ship_pending(); });
+    }
+  }
+
+  // -- reference counting -----------------------------------------------------
+
+  void ref() const noexcept final {
+    ref_count_.inc();
+  }
+
+  void deref() const noexcept final {
+    ref_count_.dec(this);
+  }
+
+private:
+  intrusive_ptr<window_reduce_sub> strong_this() {
+    return {this, add_ref};
+  }
+
+  // Requests more items unless a result waits for demand. Since the operator
+  // never stores raw items, we only need to bound the number of in-flight
+  // items.
+  void pull() {
+    if (!sub_ || pending_)
+      return;
+    constexpr auto max_in_flight = defaults::flow::buffer_size;
+    if (in_flight_ <= max_in_flight / 2) {
+      auto n = max_in_flight - in_flight_;
+      in_flight_ += n;
+      sub_.request(n);
+    }
+  }
+
+  // Computes the result for the current window, emits it and opens the next
+  // pane.
+  void close_pane() {
+    CAF_ASSERT(!pending_);
+    pane_items_ = 0;
+    if constexpr (std::is_same_v<Merge, unit_t>) {
+      CAF_ASSERT(spec_.panes == 1);
+      emit(std::exchange(panes_[0], init_));
+    } else {
+      closed_panes_ = std::min(closed_panes_ + 1, spec_.panes);
+      auto result = init_;
+      auto first = index_ + spec_.panes + 1 - closed_panes_;
+      for (size_t offset = 0; offset < closed_panes_; ++offset)
+        window_reduce_fold(merge_, result,
+                           panes_[(first + offset) % spec_.panes]);
+      index_ = (index_ + 1) % spec_.panes;
+      panes_[index_] = init_;
+      emit(std::move(result));
+    }
+  }
+
+  void emit(Acc result) {
+    if (demand_ > 0) {
+      --demand_;
+      out_.on_next(result);
+    } else {
+      pending_ = std::move(result);
+    }
+  }
+
+  void ship_pending() {
+    if (!out_ || !pending_ || demand_ == 0)
+      return;
+    --demand_;
+    auto result = std::move(*pending_);
+    pending_.reset();
+    out_.on_next(result);
+    if (!out_) // on_next might call cancel()
+      return;
+    if (input_done_) {
+      if (pane_items_ > 0)
+        close_pane();
+      if (!pending_)
+        out_.on_complete();
+      return;
+    }
+    pull();
+  }
+
+  void start_timer(steady_time_point when) {
+    timer_ = parent_->delay_until_fn(when, [ptr = strong_this()] {
+      ptr->timer_ = disposable{};
+      ptr->on_tick();
+    });
+  }
+
+  void on_tick() {
+    if (!out_)
+      return;
+    auto now = parent_->steady_time();
+    if (spec_.session) {
+      // While a result waits for demand, the session remains open.
+      if (!pending_ && now - last_item_ >= spec_.period) {
+        close_pane();
+        return;
+      }
+      start_timer(pending_ ? now + spec_.period : last_item_ + spec_.period);
+      return;
+    }
+    // While a result waits for demand, the current pane remains open.
+    if (!pending_)
+      close_pane();
+    next_tick_ += spec_.period;
+    start_timer(next_tick_);
+  }
+
+  void do_dispose(bool from_external) override {
+    if (!out_)
+      return;
+    sub_.cancel();
+    timer_.dispose();
+    if (from_external)
+      out_.on_error(make_error(sec::disposed));
+    else
+      out_.release_later();
+  }
+
+  // -- member variables -------------------------------------------------------
+
+  mutable detail::atomic_ref_count ref_count_;
+
+  /// Our scheduling context.
+  coordinator* parent_;
+
+  /// The observer for the window results.
+  observer<Acc> out_;
+
+  /// Configures the windows.
+  window_reduce_spec spec_;
+
+  /// Initial value for each pane and each window.
+  Acc init_;
+
+  /// Folds items into the accumulator of a pane.
+  Fold fold_;
+
+  /// Folds panes into the result of a window. Only used for sliding windows.
+  Merge merge_;
+
+  /// Stores one accumulator per pane. Allocated once.
+  std::vector<Acc> panes_;
+
+  /// Stores the position of the current pane.
+  size_t index_ = 0;
+
+  /// Stores how many panes have closed, up to `spec_.panes`.
+  size_t closed_panes_ = 0;
+
+  /// Stores how many items the current pane has received.
+  size_t pane_items_ = 0;
+
+  /// Stores a result that waits for demand. While holding a result, the
+  /// operator stops requesting items.
+  std::optional<Acc> pending_;
+
+  /// Pulls data from the decorated observable.
+  flow::subscription sub_;
+
+  /// Closes panes for time-based windows and sessions.
+  disposable timer_;
+
+  /// Stores when the next pane closes for time-based windows.
+  steady_time_point next_tick_;
+
+  /// Stores when the last item arrived for session windows.
+  steady_time_point last_item_;
+
+  /// Stores how many items are currently in-flight.
+  size_t in_flight_ = 0;
+
+  /// Stores the demand of the observer.
+  size_t demand_ = 0;
+
+  /// Stores whether the input has completed.
+  bool input_done_ = false;
+};
+
+/// Folds the items of an observable into an accumulator per window without
+/// storing the items themselves.
+template <class T, class Acc, class Fold, class Merge = unit_t>
+class window_reduce : public cold<Acc> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using super = cold<Acc>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  window_reduce(coordinator* parent, observable<T> decorated,
+                window_reduce_spec spec, Acc init, Fold fold, Merge merge = {})
+    : super(parent),
+      decorated_(std::move(decorated)),
+      spec_(spec),
+      init_(std::move(init)),
+      fold_(std::move(fold)),
+      merge_(std::move(merge)) {
+    // nop
+  }
+
+  // -- implementation of observable<T> ----------------------------------------
+
+  disposable subscribe(observer<Acc> out) override {
+    if (!spec_.valid()) {
+      return super::fail_subscription(
+        out, make_error(sec::invalid_argument,
+                        "window_reduce: invalid window specification"));
+    }
+    using impl_t = window_reduce_sub<T, Acc, Fold, Merge>;
+    auto ptr = super::parent_->add_child(std::in_place_type<impl_t>, out,
+                                         spec_, init_, fold_, merge_);
+    ptr->init();
+    out.on_subscribe(subscription{ptr});
+    decorated_.subscribe(observer<T>{ptr});
+    return ptr->as_disposable();
+  }
+
+private:
+  observable<T> decorated_;
+  window_reduce_spec spec_;
+  Acc init_;
+  Fold fold_;
+  Merge merge_;
+};
+
+} // namespace caf::flow::op
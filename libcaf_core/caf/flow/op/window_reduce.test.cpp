@@ -0,0 +1,211 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/flow/op/window_reduce.hpp"
+
+#include "caf/test/caf_test_main.hpp"
+#include "caf/test/fixture/deterministic.hpp"
+#include "caf/test/fixture/flow.hpp"
+#include "caf/test/scenario.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/event_based_actor.hpp"
+#include "caf/flow/multicaster.hpp"
+#include "caf/flow/observable.hpp"
+#include "caf/log/test.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+using ivec = std::vector<int>;
+
+struct stats {
+  int count = 0;
+  int sum = 0;
+};
+
+bool operator==(const stats& lhs, const stats& rhs) {
+  return lhs.count == rhs.count && lhs.sum == rhs.sum;
+}
+
+struct fixture : test::fixture::deterministic, test::fixture::flow {
+  // Spawns an actor that applies `fn` to the items of `pub` and stores the
+  // results in the returned vector.
+  template <class Fn>
+  std::shared_ptr<ivec> run_on_actor(caf::flow::multicaster<int>& pub, Fn fn) {
+    auto outputs = std::make_shared<ivec>();
+    sys.spawn([&pub, outputs, fn](event_based_actor* self) {
+      fn(pub.as_observable().observe_on(self)).for_each([outputs](int x) {
+        outputs->push_back(x);
+      });
+    });
+    dispatch_messages();
+    return outputs;
+  }
+
+  void run_all() {
+    run_flows();
+    dispatch_messages();
+  }
+};
+
+auto plus = [](int x, int y) { return x + y; };
+
+} // namespace
+
+WITH_FIXTURE(fixture) {
+
+SCENARIO("window_reduce folds items in tumbling windows by count") {
+  GIVEN("an observable with the numbers 1 to 10") {
+    WHEN("reducing windows of three items") {
+      THEN("the observer receives the sum of each window") {
+        auto outputs = ivec{};
+        make_observable()
+          .iota(1)
+          .take(10)
+          .window_reduce(3, 0, plus)
+          .for_each([&outputs](int x) { outputs.push_back(x); });
+        run_flows();
+        check_eq(outputs, ivec{6, 15, 24, 10});
+      }
+    }
+    WHEN("using an in-place fold") {
+      THEN("the observer receives the accumulator of each window") {
+        auto outputs = std::vector<stats>{};
+        auto fold = [](stats& acc, int x) {
+          ++acc.count;
+          acc.sum += x;
+        };
+        make_observable()
+          .iota(1)
+          .take(10)
+          .window_reduce(5, stats{}, fold)
+          .for_each([&outputs](const stats& x) { outputs.push_back(x); });
+        run_flows();
+        check(outputs == std::vector<stats>{{5, 15}, {5, 40}});
+      }
+    }
+  }
+}
+
+SCENARIO("window_reduce folds items in sliding windows by count") {
+  GIVEN("an observable with the numbers 1 to 8") {
+    WHEN("reducing windows of four items that advance by two items") {
+      THEN("the observer receives the sum of each window") {
+        auto outputs = ivec{};
+        make_observable()
+          .iota(1)
+          .take(8)
+          .window_reduce(4, 2, 0, plus, plus)
+          .for_each([&outputs](int x) { outputs.push_back(x); });
+        run_flows();
+        check_eq(outputs, ivec{3, 10, 18, 26});
+      }
+    }
+  }
+}
+
+SCENARIO("window_reduce rejects invalid windows") {
+  GIVEN("a sliding window with a length that is no multiple of its step") {
+    WHEN("subscribing to the operator") {
+      THEN("the observer receives an invalid_argument error") {
+        auto result = error{};
+        make_observable()
+          .iota(1)
+          .take(8)
+          .window_reduce(5, 2, 0, plus, plus)
+          .do_on_error([&result](const error& err) { result = err; })
+          .for_each([this](int) { fail("unexpected item"); });
+        run_flows();
+        check_eq(result, sec::invalid_argument);
+      }
+    }
+  }
+}
+
+SCENARIO("window_reduce folds items in tumbling windows by time") {
+  GIVEN("a window_reduce operator with a period of 1s") {
+    WHEN("the input produces items") {
+      THEN("the observer receives one result per period") {
+        auto pub = caf::flow::multicaster<int>{coordinator()};
+        auto outputs = run_on_actor(pub, [](auto&& in) {
+          return std::move(in).window_reduce(1s, 0, plus);
+        });
+        pub.push({1, 2});
+        run_all();
+        check_eq(*outputs, ivec{});
+        advance_time(1s);
+        run_all();
+        check_eq(*outputs, ivec{3});
+        log::test::debug("empty windows emit the initial value");
+        advance_time(1s);
+        run_all();
+        check_eq(*outputs, ivec{3, 0});
+        log::test::debug("completing the input emits the last window");
+        pub.push(5);
+        pub.close();
+        run_all();
+        check_eq(*outputs, ivec{3, 0, 5});
+      }
+    }
+  }
+}
+
+SCENARIO("window_reduce folds items in sliding windows by time") {
+  GIVEN("a window_reduce operator with a length of 2s and a step of 1s") {
+    WHEN("the input produces items") {
+      THEN("the observer receives one result per step") {
+        auto pub = caf::flow::multicaster<int>{coordinator()};
+        auto outputs = run_on_actor(pub, [](auto&& in) {
+          return std::move(in).window_reduce(2s, 1s, 0, plus, plus);
+        });
+        pub.push(1);
+        run_all();
+        advance_time(1s);
+        run_all();
+        pub.push(2);
+        run_all();
+        advance_time(1s);
+        run_all();
+        advance_time(1s);
+        run_all();
+        check_eq(*outputs, ivec{1, 3, 2});
+      }
+    }
+  }
+}
+
+SCENARIO("session_reduce folds items until the input becomes idle") {
+  GIVEN("a session_reduce operator with a gap of 1s") {
+    WHEN("the input pauses for at least 1s") {
+      THEN("the observer receives the result for the session") {
+        auto pub = caf::flow::multicaster<int>{coordinator()};
+        auto outputs = run_on_actor(pub, [](auto&& in) {
+          return std::move(in).session_reduce(1s, 0, plus);
+        });
+        pub.push({1, 2});
+        run_all();
+        advance_time(500ms);
+        run_all();
+        pub.push(3);
+        run_all();
+        check_eq(*outputs, ivec{});
+        advance_time(1s);
+        run_all();
+        check_eq(*outputs, ivec{6});
+        pub.push(4);
+        pub.close();
+        run_all();
+        check_eq(*outputs, ivec{6, 4});
+      }
+    }
+  }
+}
+
+} // WITH_FIXTURE(fixture)
@@ -369,6 +369,7 @@ struct meta_object;
 class abstract_monitor_action;
 class abstract_worker;
 class abstract_worker_hub;
+class actor_slab;
 class actor_system_access;
 class actor_system_config_access;
 class asynchronous_logger;
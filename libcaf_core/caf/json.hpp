@@ -7,6 +7,7 @@
 #include "caf/json_array.hpp"
 #include "caf/json_builder.hpp"
 #include "caf/json_object.hpp"
+#include "caf/json_pull_reader.hpp"
 #include "caf/json_reader.hpp"
 #include "caf/json_value.hpp"
 #include "caf/json_writer.hpp"
@@ -0,0 +1,1240 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/json_pull_reader.hpp"
+
+#include "caf/actor_control_block.hpp"
+#include "caf/actor_handle_codec.hpp"
+#include "caf/byte_span.hpp"
+#include "caf/deserializer.hpp"
+#include "caf/detail/assert.hpp"
+#include "caf/detail/bounds_checker.hpp"
+#include "caf/detail/json.hpp"
+#include "caf/detail/parser/read_number.hpp"
+#include "caf/detail/swar.hpp"
+#include "caf/format_to_error.hpp"
+#include "caf/parser_state.hpp"
+#include "caf/pec.hpp"
+
+#include <cstring>
+#include <limits>
+#include <memory_resource>
+#include <variant>
+#include <vector>
+
+namespace {
+
+static constexpr const char class_name[] = "caf::json_pull_reader";
+
+/// Same limit as the DOM parser in order to accept the same inputs.
+constexpr size_t max_nesting_level = 128;
+
+/// Stores the extent of a JSON object or array. The reader stores one entry
+/// per container in document order.
+struct container_info {
+  /// Offset past the closing bracket.
+  size_t end = 0;
+
+  /// Number of elements or members.
+  size_t size = 0;
+
+  /// Number of containers nested within this container.
+  size_t nested = 0;
+};
+
+using number = std::variant<int64_t, uint64_t, double>;
+
+struct number_consumer {
+  number* ptr;
+
+  template <class T>
+  void value(T x) {
+    *ptr = x;
+  }
+};
+
+bool is_whitespace(char ch) noexcept {
+  switch (ch) {
+    case ' ':
+    case '\f':
+    case '\n':
+    case '\r':
+    case '\t':
+    case '\v':
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool is_number_start(char ch) noexcept {
+  return (ch >= '0' && ch <= '9') || ch == '+' || ch == '-' || ch == '.';
+}
+
+bool is_hex(char ch) noexcept {
+  return (ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'f')
+         || (ch >= 'A' && ch <= 'F');
+}
+
+// Returns the offset of the next quote or backslash in `str`, starting at
+// `offset`, or `str.size()` if there is none.
+size_t find_quote_or_backslash(std::string_view str, size_t offset) noexcept {
+  auto first = str.data();
+  auto pos = caf::detail::swar::find_first_of<'"', '\\'>(first + offset,
+                                                          first + str.size());
+  return static_cast<size_t>(pos - first);
+}
+
+/// Parses a number at the beginning of @p str.
+caf::pec parse_number(std::string_view str, number& result, size_t& consumed) {
+  caf::string_parser_state ps{str.begin(), str.end()};
+  number_consumer f{&result};
+  caf::detail::parser::read_number(ps, f);
+  consumed = static_cast<size_t>(ps.i - str.begin());
+  return ps.code <= caf::pec::trailing_character ? caf::pec::success : ps.code;
+}
+
+/// Validates a JSON input and builds the index of all containers.
+class indexer {
+public:
+  indexer(std::string_view input, std::vector<container_info>& index)
+    : input_(input), index_(index) {
+    // nop
+  }
+
+  /// Validates the input and returns `pec::success` on success.
+  caf::pec run() {
+    if (value(0)) {
+      skip_whitespace();
+      if (pos_ != input_.size())
+        code_ = caf::pec::trailing_character;
+    }
+    return code_;
+  }
+
+  /// Returns the offset where the indexer stopped.
+  size_t pos() const noexcept {
+    return pos_;
+  }
+
+private:
+  bool at_end() const noexcept {
+    return pos_ == input_.size();
+  }
+
+  bool fail(caf::pec code) {
+    code_ = code;
+    return false;
+  }
+
+  bool fail_at_current() {
+    return fail(at_end() ? caf::pec::unexpected_eof
+                         : caf::pec::unexpected_character);
+  }
+
+  void skip_whitespace() {
+    while (!at_end() && is_whitespace(input_[pos_]))
+      ++pos_;
+  }
+
+  bool value(size_t nesting_level) {
+    skip_whitespace();
+    if (at_end())
+      return fail(caf::pec::unexpected_eof);
+    switch (input_[pos_]) {
+      case '"':
+        return string();
+      case '{':
+        return container(nesting_level, true);
+      case '[':
+        return container(nesting_level, false);
+      case 't':
+        return literal("true");
+      case 'f':
+        return literal("false");
+      case 'n':
+        return literal(input_.substr(pos_).starts_with("nan") ? "nan" : "null");
+      default:
+        if (is_number_start(input_[pos_]))
+          return num();
+        return fail(caf::pec::unexpected_character);
+    }
+  }
+
+  bool literal(std::string_view str) {
+    if (input_.substr(pos_).starts_with(str)) {
+      pos_ += str.size();
+      return true;
+    }
+    return fail(caf::pec::unexpected_character);
+  }
+
+  bool num() {
+    number tmp;
+    size_t consumed = 0;
+    auto code = parse_number(input_.substr(pos_), tmp, consumed);
+    pos_ += consumed;
+    if (code != caf::pec::success)
+      return fail(code);
+    return true;
+  }
+
+  // Reads 4 hex digits following a '\u' escape.
+  bool code_unit(uint16_t& result) {
+    result = 0;
+    for (int i = 0; i < 4; ++i) {
+      if (at_end() || !is_hex(input_[pos_]))
+        return fail_at_current();
+      auto ch = input_[pos_++];
+      auto digit = ch <= '9'   ? ch - '0'
+                   : ch <= 'F' ? ch - 'A' + 10
+                               : ch - 'a' + 10;
+      result = static_cast<uint16_t>(result * 16 + digit);
+    }
+    return true;
+  }
+
+  bool string() {
+    ++pos_; // Opening quote.
+    while (!at_end()) {
+      switch (input_[pos_]) {
+        case '"':
+          ++pos_;
+          return true;
+        case '\\': {
+          if (++pos_ == input_.size())
+            return fail(caf::pec::unexpected_eof);
+          auto ch = input_[pos_++];
+          if (ch == 'u') {
+            uint16_t unit = 0;
+            if (!code_unit(unit))
+              return false;
+            if (unit >= 0xD800 && unit < 0xDC00) {
+              // A trailing surrogate must follow.
+              if (at_end() || input_[pos_] != '\\')
+                return fail_at_current();
+              ++pos_;
+              if (at_end() || input_[pos_] != 'u')
+                return fail_at_current();
+              ++pos_;
+              if (!code_unit(unit))
+                return false;
+            }
+          } else if (ch == '\0' || strchr("\"\\/bfnrtv", ch) == nullptr) {
+            --pos_;
+            return fail(caf::pec::unexpected_character);
+          }
+          break;
+        }
+        default:
+          pos_ = find_quote_or_backslash(input_, pos_);
+      }
+    }
+    return fail(caf::pec::unexpected_eof);
+  }
+
+  bool container(size_t nesting_level, bool is_object) {
+    if (nesting_level >= max_nesting_level)
+      return fail(caf::pec::nested_too_deeply);
+    auto close = is_object ? '}' : ']';
+    auto slot = index_.size();
+    index_.emplace_back();
+    ++pos_; // Opening bracket.
+    skip_whitespace();
+    size_t count = 0;
+    if (!at_end() && input_[pos_] == close) {
+      ++pos_;
+      index_[slot] = container_info{pos_, 0, 0};
+      return true;
+    }
+    for (;;) {
+      if (is_object) {
+        skip_whitespace();
+        if (at_end() || input_[pos_] != '"')
+          return fail_at_current();
+        if (!string())
+          return false;
+        skip_whitespace();
+        if (at_end() || input_[pos_] != ':')
+          return fail_at_current();
+        ++pos_;
+      }
+      if (!value(nesting_level + 1))
+        return false;
+      ++count;
+      skip_whitespace();
+      if (at_end())
+        return fail(caf::pec::unexpected_eof);
+      if (input_[pos_] == ',') {
+        ++pos_;
+        continue;
+      }
+      if (input_[pos_] == close) {
+        ++pos_;
+        break;
+      }
+      return fail(caf::pec::unexpected_character);
+    }
+    index_[slot] = container_info{pos_, count, index_.size() - slot - 1};
+    return true;
+  }
+
+  std::string_view input_;
+  size_t pos_ = 0;
+  std::vector<container_info>& index_;
+  caf::pec code_ = caf::pec::success;
+};
+
+} // namespace
+
+#define FN_DECL static constexpr const char* fn = __func__
+
+#define INVALID_AND_PAST_THE_END_CASES                                         \
+  case position::invalid:                                                      \
+    err_ = format_to_error(sec::runtime_error,                                 \
+                           "{}::{}: found an invalid position in field {}",    \
+                           class_name, fn, current_field_name());              \
+    return false;                                                              \
+  case position::past_the_end:                                                 \
+    err_ = format_to_error(sec::runtime_error,                                 \
+                           "{}::{}: unexpected end of input in field {}",      \
+                           class_name, fn, current_field_name());              \
+    return false;
+
+#define SCOPE(expected_position)                                               \
+  if (auto got = pos(); got != expected_position) {                            \
+    err_ = format_to_error(sec::runtime_error,                                 \
+                           "{}::{}: expected type {}, got {} in field {}",     \
+                           class_name, __func__,                               \
+                           pretty_name(expected_position), pretty_name(got),   \
+                           current_field_name());                              \
+    return false;                                                              \
+  }
+
+namespace caf {
+
+class json_pull_reader_impl : public text_reader {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using super = text_reader;
+
+  /// Points to a JSON value in the input.
+  struct cursor {
+    /// Offset of the first character of the value.
+    size_t offset;
+
+    /// Index of the next container at or after `offset`.
+    size_t index;
+  };
+
+  /// Points to the key of a key-value pair in the input.
+  struct key {
+    cursor pos;
+  };
+
+  struct object {
+    /// Points to the first member.
+    cursor first;
+
+    /// Points to the member following the last member we have read. Usually,
+    /// fields appear in the same order as we read them, so we start each
+    /// lookup here.
+    cursor next;
+  };
+
+  struct sequence {
+    cursor next;
+  };
+
+  struct members {
+    cursor next;
+
+    /// Points to the value of the current key-value pair.
+    cursor val;
+  };
+
+  using value_type = std::variant<cursor, object, key, sequence, members>;
+
+  /// Denotes the type at the current position.
+  enum class position {
+    value,
+    object,
+    key,
+    sequence,
+    members,
+    past_the_end,
+    invalid,
+  };
+
+  template <position P>
+  auto& top() noexcept {
+    return std::get<static_cast<size_t>(P)>(st_.back());
+  }
+
+  template <position P>
+  const auto& top() const noexcept {
+    return std::get<static_cast<size_t>(P)>(st_.back());
+  }
+
+  // -- constants --------------------------------------------------------------
+
+  /// The value value for `field_type_suffix()`.
+  static constexpr std::string_view field_type_suffix_default = "-type";
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit json_pull_reader_impl(caf::actor_handle_codec* codec)
+    : codec_(codec) {
+    st_.reserve(16);
+    field_.reserve(8);
+  }
+
+  json_pull_reader_impl(const json_pull_reader_impl&) = delete;
+
+  json_pull_reader_impl& operator=(const json_pull_reader_impl&) = delete;
+
+  ~json_pull_reader_impl() override {
+    // nop
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  [[nodiscard]] std::string_view field_type_suffix() const noexcept override {
+    return field_type_suffix_;
+  }
+
+  void field_type_suffix(std::string_view suffix) noexcept override {
+    field_type_suffix_ = suffix;
+  }
+
+  [[nodiscard]] const type_id_mapper* mapper() const noexcept override {
+    return mapper_;
+  }
+
+  void mapper(const type_id_mapper* ptr) noexcept override {
+    mapper_ = ptr;
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  void set_error(error stop_reason) override {
+    err_ = std::move(stop_reason);
+  }
+
+  error& get_error() noexcept override {
+    return err_;
+  }
+
+  bool load(std::string_view json_text) override {
+    reset();
+    indexer idx{json_text, index_};
+    if (auto code = idx.run(); code != pec::success) {
+      err_ = make_parse_error(code, json_text.substr(0, idx.pos()));
+      index_.clear();
+      return false;
+    }
+    input_ = json_text;
+    loaded_ = true;
+    revert();
+    return true;
+  }
+
+  bool load_bytes(const_byte_span bytes) override {
+    return load(to_string_view(bytes));
+  }
+
+  void revert() override {
+    if (loaded_) {
+      err_.reset();
+      st_.clear();
+      st_.emplace_back(cursor{skip_whitespace(0), 0});
+      field_.clear();
+    }
+  }
+
+  void reset() override {
+    buf_.release();
+    input_ = std::string_view{};
+    index_.clear();
+    st_.clear();
+    loaded_ = false;
+    err_.reset();
+    field_.clear();
+  }
+
+  // -- overrides --------------------------------------------------------------
+
+  bool has_human_readable_format() const noexcept override {
+    return true;
+  }
+
+  type_id_t to_type_id(std::string_view name) const override {
+    return (*mapper_)(name);
+  }
+
+  bool fetch_next_object_type(type_id_t& type) override {
+    std::string_view type_name;
+    if (fetch_next_object_name(type_name)) {
+      if (auto id = to_type_id(type_name); id != invalid_type_id) {
+        type = id;
+        return true;
+      }
+      err_ = format_to_error(
+        sec::runtime_error,
+        "{}::{}: no type ID available for @type: {} in field {}", class_name,
+        __func__, type_name, current_field_name());
+      return false;
+    }
+    return false;
+  }
+
+  bool fetch_next_object_name(std::string_view& type_name) override {
+    FN_DECL;
+    return consume<false>(fn, [this, &type_name](cursor val) {
+      if (peek(val) == '{') {
+        auto obj = enter_object(val);
+        cursor type_val;
+        if (find_member(obj, "@type", type_val, false)) {
+          if (peek(type_val) == '"') {
+            type_name = read_string(type_val);
+            return true;
+          }
+          err_ = format_to_error(
+            sec::runtime_error,
+            "{}::{}: expected a string argument to @type in field {}",
+            class_name, fn, current_field_name());
+          return false;
+        }
+        err_ = format_to_error(sec::runtime_error,
+                               "{}::{}: found no @type member in field {}",
+                               class_name, fn, current_field_name());
+        return false;
+      }
+      err_ = format_to_error(
+        sec::runtime_error,
+        "{}::{}: expected type json::object, got {} in field {}", class_name,
+        fn, type_name_from(val), current_field_name());
+      return false;
+    });
+  }
+
+  bool begin_object(type_id_t, std::string_view) override {
+    FN_DECL;
+    return consume<false>(fn, [this](cursor val) {
+      if (peek(val) == '{') {
+        push(enter_object(val));
+        return true;
+      }
+      err_ = format_to_error(
+        sec::runtime_error,
+        "{}::{}: expected type json::object, got {} in field {}", class_name,
+        fn, type_name_from(val), current_field_name());
+      return false;
+    });
+  }
+
+  bool end_object() override {
+    FN_DECL;
+    SCOPE(position::object);
+    pop();
+    auto current_pos = pos();
+    switch (current_pos) {
+      INVALID_AND_PAST_THE_END_CASES
+      case position::value:
+        pop();
+        return true;
+      case position::sequence: {
+        auto& seq = top<position::sequence>();
+        seq.next = next_element(skip(seq.next));
+        return true;
+      }
+      default:
+        err_ = format_to_error(sec::runtime_error,
+                               "{}::{}: expected type json::value or "
+                               "json::array, got {} in field {}",
+                               class_name, fn, pretty_name(current_pos),
+                               current_field_name());
+        return false;
+    }
+  }
+
+  bool begin_field(std::string_view name) override {
+    SCOPE(position::object);
+    field_.push_back(name);
+    cursor val;
+    if (find_member(top<position::object>(), name, val, true)) {
+      push(val);
+      return true;
+    }
+    err_ = format_to_error(sec::runtime_error,
+                           "{}::{}: mandatory key {} missing in field {}",
+                           class_name, __func__, name, current_field_name());
+    return false;
+  }
+
+  bool begin_field(std::string_view name, bool& is_present) override {
+    SCOPE(position::object);
+    field_.push_back(name);
+    cursor val;
+    if (find_member(top<position::object>(), name, val, true)
+        && !is_null(val)) {
+      push(val);
+      is_present = true;
+    } else {
+      is_present = false;
+    }
+    return true;
+  }
+
+  bool begin_field(std::string_view name, std::span<const type_id_t> types,
+                   size_t& index) override {
+    bool is_present = false;
+    if (begin_field(name, is_present, types, index)) {
+      if (is_present)
+        return true;
+      err_ = format_to_error(sec::runtime_error,
+                             "{}::{}: mandatory key {} missing in field {}",
+                             class_name, __func__, name, current_field_name());
+      return false;
+    }
+    return false;
+  }
+
+  bool begin_field(std::string_view name, bool& is_present,
+                   std::span<const type_id_t> types, size_t& index) override {
+    SCOPE(position::object);
+    field_.push_back(name);
+    auto& obj = top<position::object>();
+    cursor val;
+    if (find_member(obj, name, val, true) && !is_null(val)) {
+      auto ft = field_type(obj, name);
+      if (auto id = to_type_id(ft); id != invalid_type_id) {
+        if (auto i = std::ranges::find(types, id); i != types.end()) {
+          index = static_cast<size_t>(std::distance(types.begin(), i));
+          push(val);
+          is_present = true;
+          return true;
+        }
+      }
+    }
+    is_present = false;
+    return true;
+  }
+
+  bool end_field() override {
+    SCOPE(position::object);
+    if (!field_.empty())
+      field_.pop_back();
+    return true;
+  }
+
+  bool begin_tuple(size_t size) override {
+    size_t list_size = 0;
+    if (begin_sequence(list_size)) {
+      if (list_size == size)
+        return true;
+      err_ = format_to_error(sec::conversion_failed,
+                             "{}::{}: expected tuple of size {} in field {}, "
+                             "got a list of size {}",
+                             class_name, __func__, size, current_field_name(),
+                             list_size);
+      return false;
+    }
+    return false;
+  }
+
+  bool end_tuple() override {
+    return end_sequence();
+  }
+
+  bool begin_key_value_pair() override {
+    SCOPE(position::members);
+    if (auto& xs = top<position::members>(); peek(xs.next) != '}') {
+      auto key_pos = xs.next;
+      xs.val = member_value(key_pos);
+      push(xs.val);
+      push(key{key_pos});
+      return true;
+    }
+    err_ = format_to_error(
+      sec::runtime_error,
+      "{}::{}: tried reading a JSON::object sequentially past its end",
+      class_name, __func__);
+    return false;
+  }
+
+  bool end_key_value_pair() override {
+    SCOPE(position::members);
+    auto& xs = top<position::members>();
+    xs.next = next_element(skip(xs.val));
+    return true;
+  }
+
+  bool begin_sequence(size_t& size) override {
+    FN_DECL;
+    return consume<false>(fn, [this, &size](cursor val) {
+      if (peek(val) == '[') {
+        size = index_[val.index].size;
+        push(sequence{enter(val)});
+        return true;
+      }
+      err_ = format_to_error(
+        sec::runtime_error,
+        "{}::{}: expected type json::array, got {} in field {}", class_name,
+        fn, type_name_from(val), current_field_name());
+      return false;
+    });
+  }
+
+  bool end_sequence() override {
+    SCOPE(position::sequence);
+    if (peek(top<position::sequence>().next) == ']') {
+      pop();
+      // We called consume<false> at first, so we need to call it again with
+      // <true> for advancing the position now.
+      return consume<true>(__func__, [](cursor) { return true; });
+    }
+    err_ = format_to_error(
+      sec::runtime_error,
+      "{}::{}: failed to consume all elements from json::array", class_name,
+      __func__);
+    return false;
+  }
+
+  bool begin_associative_array(size_t& size) override {
+    FN_DECL;
+    return consume<false>(fn, [this, &size](cursor val) {
+      if (peek(val) == '{') {
+        size = index_[val.index].size;
+        auto first = enter(val);
+        push(members{first, first});
+        return true;
+      }
+      err_ = format_to_error(
+        sec::runtime_error,
+        "{}::{}: expected type json::object, got {} in field {}", class_name,
+        fn, type_name_from(val), current_field_name());
+      return false;
+    });
+  }
+
+  bool end_associative_array() override {
+    SCOPE(position::members);
+    if (peek(top<position::members>().next) == '}') {
+      pop();
+      return consume<true>(__func__, [](cursor) { return true; });
+    }
+    err_ = format_to_error(
+      sec::runtime_error,
+      "{}::{}: failed to consume all elements in an associative array",
+      class_name, __func__);
+    return false;
+  }
+
+  bool value(std::byte& x) override {
+    auto tmp = uint8_t{0};
+    if (value(tmp)) {
+      x = static_cast<std::byte>(tmp);
+      return true;
+    }
+    return false;
+  }
+
+  bool value(bool& x) override {
+    FN_DECL;
+    return consume<true>(fn, [this, &x](cursor val) {
+      switch (peek(val)) {
+        case 't':
+          x = true;
+          return true;
+        case 'f':
+          x = false;
+          return true;
+        default:
+          err_ = format_to_error(
+            sec::runtime_error,
+            "{}::{}: expected type json::boolean, got {} in field {}",
+            class_name, fn, type_name_from(val), current_field_name());
+          return false;
+      }
+    });
+  }
+
+  bool value(int8_t& x) override {
+    return integer(x);
+  }
+
+  bool value(uint8_t& x) override {
+    return integer(x);
+  }
+
+  bool value(int16_t& x) override {
+    return integer(x);
+  }
+
+  bool value(uint16_t& x) override {
+    return integer(x);
+  }
+
+  bool value(int32_t& x) override {
+    return integer(x);
+  }
+
+  bool value(uint32_t& x) override {
+    return integer(x);
+  }
+
+  bool value(int64_t& x) override {
+    return integer(x);
+  }
+
+  bool value(uint64_t& x) override {
+    return integer(x);
+  }
+
+  bool value(float& x) override {
+    auto tmp = 0.0;
+    if (value(tmp)) {
+      x = static_cast<float>(tmp);
+      return true;
+    }
+    return false;
+  }
+
+  bool value(double& x) override {
+    FN_DECL;
+    return consume<true>(fn, [this, &x](cursor val) {
+      number num;
+      if (read_number(val, num)) {
+        auto to_double = [](auto y) { return static_cast<double>(y); };
+        x = std::visit(to_double, num);
+        return true;
+      }
+      err_ = format_to_error(sec::runtime_error,
+                             "{}::{}: expected type json::real, "
+                             "got {} in field {}",
+                             class_name, fn, type_name_from(val),
+                             current_field_name());
+      return false;
+    });
+  }
+
+  bool value(long double& x) override {
+    auto tmp = 0.0;
+    if (value(tmp)) {
+      x = static_cast<long double>(tmp);
+      return true;
+    }
+    return false;
+  }
+
+  bool value(std::string& x) override {
+    FN_DECL;
+    return consume<true>(fn, [this, &x](cursor val) {
+      if (peek(val) == '"') {
+        x = read_string(val);
+        return true;
+      }
+      err_ = format_to_error(sec::runtime_error,
+                             "{}::{}: expected type json::string, "
+                             "got {} in field {}",
+                             class_name, fn, type_name_from(val),
+                             current_field_name());
+      return false;
+    });
+  }
+
+  bool value(std::u16string&) override {
+    err_ = format_to_error(sec::runtime_error,
+                           "{}::{}: u16string support not implemented yet",
+                           class_name, __func__);
+    return false;
+  }
+
+  bool value(std::u32string&) override {
+    err_ = format_to_error(sec::runtime_error,
+                           "{}::{}: u32string support not implemented yet",
+                           class_name, __func__);
+    return false;
+  }
+
+  bool value(byte_span) override {
+    err_ = format_to_error(sec::runtime_error,
+                           "{}::{}: byte span support not implemented yet",
+                           class_name, __func__);
+    return false;
+  }
+
+  caf::actor_handle_codec* actor_handle_codec() override {
+    return codec_;
+  }
+
+private:
+  // -- navigating the input ---------------------------------------------------
+
+  static error make_parse_error(pec code, std::string_view consumed) {
+    auto line = int32_t{1};
+    auto column = int32_t{1};
+    for (auto ch : consumed) {
+      if (ch == '\n') {
+        ++line;
+        column = 1;
+      } else {
+        ++column;
+      }
+    }
+    return parser_state_to_error(code, line, column);
+  }
+
+  char peek(cursor x) const noexcept {
+    return input_[x.offset];
+  }
+
+  size_t skip_whitespace(size_t offset) const noexcept {
+    while (offset < input_.size() && is_whitespace(input_[offset]))
+      ++offset;
+    return offset;
+  }
+
+  /// Returns the offset past the closing quote of the string at `offset`.
+  size_t skip_string(size_t offset, bool& escaped) const noexcept {
+    ++offset; // Opening quote.
+    for (;;) {
+      switch (input_[offset]) {
+        case '"':
+          return offset + 1;
+        case '\\':
+          escaped = true;
+          offset += 2;
+          break;
+        default:
+          offset = find_quote_or_backslash(input_, offset);
+      }
+    }
+  }
+
+  /// Returns a cursor to the first character past the value at `x`.
+  cursor skip(cursor x) const noexcept {
+    switch (peek(x)) {
+      case '{':
+      case '[': {
+        const auto& info = index_[x.index];
+        return {info.end, x.index + info.nested + 1};
+      }
+      case '"': {
+        bool escaped = false;
+        return {skip_string(x.offset, escaped), x.index};
+      }
+      default: {
+        auto offset = x.offset;
+        while (offset < input_.size() && !is_whitespace(input_[offset])
+               && input_[offset] != ',' && input_[offset] != ']'
+               && input_[offset] != '}')
+          ++offset;
+        return {offset, x.index};
+      }
+    }
+  }
+
+  /// Moves past the separator after a value, i.e., returns a cursor to the
+  /// next element or to the closing bracket.
+  cursor next_element(cursor x) const noexcept {
+    x.offset = skip_whitespace(x.offset);
+    if (input_[x.offset] == ',')
+      x.offset = skip_whitespace(x.offset + 1);
+    return x;
+  }
+
+  /// Returns a cursor to the first element of the container at `x`.
+  cursor enter(cursor x) const noexcept {
+    return {skip_whitespace(x.offset + 1), x.index + 1};
+  }
+
+  object enter_object(cursor x) const noexcept {
+    auto first = enter(x);
+    return object{first, first};
+  }
+
+  /// Returns a cursor to the value of the member with its key at `x`.
+  cursor member_value(cursor x) const noexcept {
+    bool escaped = false;
+    x.offset = skip_whitespace(skip_string(x.offset, escaped));
+    CAF_ASSERT(input_[x.offset] == ':');
+    x.offset = skip_whitespace(x.offset + 1);
+    return x;
+  }
+
+  /// Returns the string at `x`. Only allocates memory for unescaping.
+  std::string_view read_string(cursor x) {
+    bool escaped = false;
+    auto end = skip_string(x.offset, escaped);
+    auto str = input_.substr(x.offset + 1, end - x.offset - 2);
+    if (!escaped)
+      return str;
+    return detail::json::unescape(str, &buf_);
+  }
+
+  bool read_number(cursor x, number& result) const {
+    if (input_.compare(x.offset, 3, "nan") == 0) {
+      result = std::numeric_limits<double>::quiet_NaN();
+      return true;
+    }
+    if (!is_number_start(peek(x)))
+      return false;
+    size_t consumed = 0;
+    return parse_number(input_.substr(x.offset), result, consumed)
+           == pec::success;
+  }
+
+  bool is_null(cursor x) const noexcept {
+    return input_.compare(x.offset, 4, "null") == 0;
+  }
+
+  /// Searches for the member `name` in `obj`, starting at `obj.next` and
+  /// wrapping around at the end. Sets `obj.next` to the member following the
+  /// match if `advance` is `true`.
+  bool find_member(object& obj, std::string_view name, cursor& result,
+                   bool advance) {
+    auto matches = [this, name](cursor key_pos) {
+      return read_string(key_pos) == name;
+    };
+    auto start = obj.next;
+    for (auto i = start; peek(i) != '}';) {
+      auto val = member_value(i);
+      auto next = next_element(skip(val));
+      if (matches(i)) {
+        result = val;
+        if (advance)
+          obj.next = next;
+        return true;
+      }
+      i = next;
+    }
+    for (auto i = obj.first; i.offset != start.offset;) {
+      auto val = member_value(i);
+      auto next = next_element(skip(val));
+      if (matches(i)) {
+        result = val;
+        if (advance)
+          obj.next = next;
+        return true;
+      }
+      i = next;
+    }
+    return false;
+  }
+
+  /// Returns the type annotation for the variant field `name` in `obj`, i.e.,
+  /// the string value of the member "@<name><field_type_suffix>".
+  std::string_view field_type(const object& obj, std::string_view name) {
+    for (auto i = obj.first; peek(i) != '}';) {
+      auto val = member_value(i);
+      if (peek(val) == '"') {
+        auto key = read_string(i);
+        if (key.size() == name.size() + field_type_suffix_.size() + 1
+            && key[0] == '@' && key.substr(1, name.size()) == name
+            && key.substr(name.size() + 1) == field_type_suffix_)
+          return read_string(val);
+      }
+      i = next_element(skip(val));
+    }
+    return {};
+  }
+
+  std::string_view type_name_from(cursor x) const {
+    using namespace std::literals;
+    switch (peek(x)) {
+      case '{':
+        return "json::object"sv;
+      case '[':
+        return "json::array"sv;
+      case '"':
+        return "json::string"sv;
+      case 't':
+      case 'f':
+        return "json::boolean"sv;
+      default: {
+        number num;
+        if (!read_number(x, num))
+          return "json::null"sv;
+        if (std::holds_alternative<double>(num))
+          return "json::real"sv;
+        return "json::integer"sv;
+      }
+    }
+  }
+
+  // -- stack management -------------------------------------------------------
+
+  [[nodiscard]] position pos() const noexcept {
+    if (!loaded_)
+      return position::invalid;
+    if (st_.empty())
+      return position::past_the_end;
+    return static_cast<position>(st_.back().index());
+  }
+
+  void append_current_field_name(std::string& result) {
+    result += "ROOT";
+    for (auto& key : field_) {
+      result += '.';
+      result.insert(result.end(), key.begin(), key.end());
+    }
+  }
+
+  std::string current_field_name() {
+    std::string result;
+    append_current_field_name(result);
+    return result;
+  }
+
+  template <bool PopOrAdvanceOnSuccess, class F>
+  bool consume(const char* fn, F f) {
+    auto current_pos = pos();
+    switch (current_pos) {
+      INVALID_AND_PAST_THE_END_CASES
+      case position::value:
+        if (f(top<position::value>())) {
+          if constexpr (PopOrAdvanceOnSuccess)
+            pop();
+          return true;
+        }
+        return false;
+      case position::key:
+        if (f(top<position::key>().pos)) {
+          if constexpr (PopOrAdvanceOnSuccess)
+            pop();
+          return true;
+        }
+        return false;
+      case position::sequence:
+        if (auto& ls = top<position::sequence>(); peek(ls.next) != ']') {
+          auto curr = ls.next;
+          if constexpr (PopOrAdvanceOnSuccess)
+            ls.next = next_element(skip(curr));
+          return f(curr);
+        }
+        err_ = format_to_error(
+          sec::runtime_error,
+          "{}::{}: tried reading a json::array past the end", class_name, fn);
+        return false;
+      default:
+        err_
+          = format_to_error(sec::runtime_error,
+                            "{}::{}: expected type json::value, json::key, or "
+                            "json::array, got {} in field {}",
+                            class_name, fn, pretty_name(current_pos),
+                            current_field_name());
+        return false;
+    }
+  }
+
+  template <class T>
+  bool integer(T& x) {
+    static constexpr const char* fn = "value";
+    return consume<true>(fn, [this, &x](cursor val) {
+      number num;
+      if (read_number(val, num)) {
+        if (auto* i64 = std::get_if<int64_t>(&num)) {
+          if (detail::bounds_checker<T>::check(*i64)) {
+            x = static_cast<T>(*i64);
+            return true;
+          }
+          err_ = format_to_error(sec::runtime_error,
+                                 "{}::{}: integer out of bounds in field {}",
+                                 class_name, fn, current_field_name());
+          return false;
+        }
+        if (auto* u64 = std::get_if<uint64_t>(&num)) {
+          if (detail::bounds_checker<T>::check(*u64)) {
+            x = static_cast<T>(*u64);
+            return true;
+          }
+          err_ = format_to_error(sec::runtime_error,
+                                 "{}::{}: integer out of bounds in field {}",
+                                 class_name, fn, current_field_name());
+          return false;
+        }
+      }
+      err_ = format_to_error(sec::runtime_error,
+                             "{}::{}: expected type json::integer, "
+                             "got {} in field {}",
+                             class_name, fn, type_name_from(val),
+                             current_field_name());
+      return false;
+    });
+  }
+
+  void pop() {
+    st_.pop_back();
+  }
+
+  template <class T>
+  void push(T&& x) {
+    st_.emplace_back(std::forward<T>(x));
+  }
+
+  std::string_view pretty_name(position pos) {
+    switch (pos) {
+      default:
+        return "invalid input";
+      case position::value:
+        return "json::value";
+      case position::object:
+        return "json::object";
+      case position::key:
+        return "json::key";
+      case position::sequence:
+        return "json::array";
+      case position::members:
+        return "json::members";
+    }
+  }
+
+  // -- member variables -------------------------------------------------------
+
+  /// The JSON input. All cursors point into this string.
+  std::string_view input_;
+
+  /// Stores the extent of each container in document order.
+  std::vector<container_info> index_;
+
+  std::vector<value_type> st_;
+
+  /// Stores whether `load` succeeded.
+  bool loaded_ = false;
+
+  /// Provides memory for unescaped strings.
+  std::pmr::monotonic_buffer_resource buf_;
+
+  std::string_view field_type_suffix_ = field_type_suffix_default;
+
+  /// Keeps track of the current field for better debugging output.
+  std::vector<std::string_view> field_;
+
+  /// The mapper implementation we use by default.
+  default_type_id_mapper default_mapper_;
+
+  /// Configures which ID mapper we use to translate between type IDs and names.
+  const type_id_mapper* mapper_ = &default_mapper_;
+
+  error err_;
+
+  caf::actor_handle_codec* codec_ = nullptr;
+};
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+json_pull_reader::json_pull_reader(caf::actor_handle_codec* codec)
+  : super(nullptr) {
+  static_assert(sizeof(json_pull_reader_impl) <= impl_storage_size);
+  impl_.reset(new (impl_storage_) json_pull_reader_impl(codec));
+}
+
+json_pull_reader::~json_pull_reader() noexcept {
+  // nop
+}
+
+} // namespace caf
@@ -0,0 +1,106 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+#include "caf/load_inspector_base.hpp"
+#include "caf/text_reader.hpp"
+
+#include <cstddef>
+
+namespace caf {
+
+/// Deserializes an inspectable object from a JSON-formatted string without
+/// building a DOM first. Unlike the @ref json_reader, this reader only
+/// validates the input and records the extent of each JSON object and array
+/// in a compact index when loading it. Deserializing then pulls values
+/// directly from the input, which keeps the memory footprint independent of
+/// the number of values and strings in the document.
+class CAF_CORE_EXPORT json_pull_reader final
+  : public load_inspector_base<json_pull_reader, text_reader> {
+public:
+  using super = load_inspector_base<json_pull_reader, text_reader>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit json_pull_reader(caf::actor_handle_codec* codec = nullptr);
+
+  json_pull_reader(const json_pull_reader&) = delete;
+
+  json_pull_reader& operator=(const json_pull_reader&) = delete;
+
+  ~json_pull_reader() noexcept override;
+
+  // -- properties -------------------------------------------------------------
+
+  [[nodiscard]] std::string_view field_type_suffix() const noexcept {
+    return impl_->field_type_suffix();
+  }
+
+  void field_type_suffix(std::string_view suffix) noexcept {
+    impl_->field_type_suffix(suffix);
+  }
+
+  [[nodiscard]] const type_id_mapper* mapper() const noexcept {
+    return impl_->mapper();
+  }
+
+  void mapper(const type_id_mapper* ptr) noexcept {
+    impl_->mapper(ptr);
+  }
+
+  /// Validates @p json_text and indexes its structure. After loading the JSON
+  /// input, the reader is ready for attempting to deserialize inspectable
+  /// objects.
+  /// @warning The reader reads all values directly from @p json_text. Hence,
+  ///          the buffer pointed to by the string view must remain valid until
+  ///          either destroying this reader or calling `reset`.
+  /// @note Implicitly calls `reset`.
+  bool load(std::string_view json_text) {
+    return impl_->load(json_text);
+  }
+
+  /// @copydoc load
+  bool load_bytes(const_byte_span bytes) {
+    return impl_->load_bytes(bytes);
+  }
+
+  /// Reverts the state of the reader back to where it was after calling `load`.
+  /// @post The reader is ready for attempting to deserialize another
+  ///       inspectable object.
+  void revert() {
+    impl_->revert();
+  }
+
+  /// Removes any loaded JSON data and reclaims memory resources.
+  void reset() {
+    impl_->reset();
+  }
+
+  bool fetch_next_object_name(std::string_view& type_name) {
+    return impl_->fetch_next_object_name(type_name);
+  }
+
+  bool next_object_name_matches(std::string_view type_name) {
+    return impl_->next_object_name_matches(type_name);
+  }
+
+  bool assert_next_object_name(std::string_view type_name) {
+    return impl_->assert_next_object_name(type_name);
+  }
+
+  bool has_human_readable_format() const noexcept {
+    return true;
+  }
+
+private:
+  static constexpr size_t impl_storage_size = 256;
+
+  /// Storage for the implementation object.
+  alignas(std::max_align_t) std::byte impl_storage_[impl_storage_size];
+};
+
+} // namespace caf
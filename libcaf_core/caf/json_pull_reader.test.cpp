@@ -0,0 +1,326 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/json_pull_reader.hpp"
+
+#include "caf/test/approx.hpp"
+#include "caf/test/scenario.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/dictionary.hpp"
+#include "caf/init_global_meta_objects.hpp"
+#include "caf/log/test.hpp"
+#include "caf/type_id.hpp"
+
+using namespace caf;
+
+using namespace std::literals;
+
+namespace tstlog = caf::log::test;
+
+namespace {
+
+struct pull_circle;
+struct pull_point;
+struct pull_rectangle;
+struct pull_request;
+struct pull_widget;
+
+} // namespace
+
+CAF_BEGIN_TYPE_ID_BLOCK(json_pull_reader_test, caf::first_custom_type_id + 270,
+                        10)
+
+  CAF_ADD_TYPE_ID(json_pull_reader_test, (pull_circle))
+  CAF_ADD_TYPE_ID(json_pull_reader_test, (pull_point))
+  CAF_ADD_TYPE_ID(json_pull_reader_test, (pull_rectangle))
+  CAF_ADD_TYPE_ID(json_pull_reader_test, (pull_request))
+  CAF_ADD_TYPE_ID(json_pull_reader_test, (pull_widget))
+
+CAF_END_TYPE_ID_BLOCK(json_pull_reader_test)
+
+namespace {
+
+TEST_INIT() {
+  caf::init_global_meta_objects<caf::id_block::json_pull_reader_test>();
+}
+
+struct pull_request {
+  int32_t a = 0;
+  int32_t b = 0;
+};
+
+[[maybe_unused]] bool operator==(const pull_request& x,
+                                 const pull_request& y) {
+  return std::tie(x.a, x.b) == std::tie(y.a, y.b);
+}
+
+template <class Inspector>
+bool inspect(Inspector& f, pull_request& x) {
+  return f.object(x).fields(f.field("a", x.a), f.field("b", x.b));
+}
+
+struct pull_point {
+  int32_t x = 0;
+  int32_t y = 0;
+};
+
+[[maybe_unused]] bool operator==(pull_point a, pull_point b) noexcept {
+  return a.x == b.x && a.y == b.y;
+}
+
+template <class Inspector>
+bool inspect(Inspector& f, pull_point& x) {
+  return f.object(x).fields(f.field("x", x.x), f.field("y", x.y));
+}
+
+struct pull_rectangle {
+  pull_point top_left;
+  pull_point bottom_right;
+};
+
+[[maybe_unused]] bool operator==(const pull_rectangle& x,
+                                 const pull_rectangle& y) noexcept {
+  return x.top_left == y.top_left && x.bottom_right == y.bottom_right;
+}
+
+template <class Inspector>
+bool inspect(Inspector& f, pull_rectangle& x) {
+  return f.object(x).fields(f.field("top-left", x.top_left),
+                            f.field("bottom-right", x.bottom_right));
+}
+
+struct pull_circle {
+  pull_point center;
+  int32_t radius = 0;
+};
+
+[[maybe_unused]] bool operator==(const pull_circle& x,
+                                 const pull_circle& y) noexcept {
+  return x.center == y.center && x.radius == y.radius;
+}
+
+template <class Inspector>
+bool inspect(Inspector& f, pull_circle& x) {
+  return f.object(x).fields(f.field("center", x.center),
+                            f.field("radius", x.radius));
+}
+
+struct pull_widget {
+  std::string color;
+  std::optional<std::string> label;
+  std::variant<pull_rectangle, pull_circle> shape;
+};
+
+[[maybe_unused]] bool operator==(const pull_widget& x,
+                                 const pull_widget& y) noexcept {
+  return std::tie(x.color, x.label, x.shape)
+         == std::tie(y.color, y.label, y.shape);
+}
+
+template <class Inspector>
+bool inspect(Inspector& f, pull_widget& x) {
+  return f.object(x).fields(f.field("color", x.color),
+                            f.field("label", x.label),
+                            f.field("shape", x.shape));
+}
+
+class widget_mapper : public type_id_mapper {
+  std::string_view operator()(type_id_t type) const override {
+    switch (type) {
+      case type_id_v<pull_rectangle>:
+        return "rectangle";
+      case type_id_v<pull_circle>:
+        return "circle";
+      default:
+        return query_type_name(type);
+    }
+  }
+  type_id_t operator()(std::string_view name) const override {
+    if (name == "rectangle")
+      return type_id_v<pull_rectangle>;
+    if (name == "circle")
+      return type_id_v<pull_circle>;
+    return query_type_id(name);
+  }
+};
+
+struct fixture {
+  // Adds a test case for a given input and expected output.
+  template <class T>
+  void add_test_case(std::string_view input, T val) {
+    auto f = [input, obj{std::move(val)}](json_pull_reader& reader) -> bool {
+      auto& this_test = test::runnable::current();
+      auto tmp = T{};
+      auto res = this_test.check(reader.load(input))    // index JSON
+                 && this_test.check(reader.apply(tmp)); // deserialize object
+      if (res) {
+        if constexpr (std::is_same_v<T, message>)
+          res = this_test.check_eq(to_string(tmp), to_string(obj));
+        else if constexpr (std::is_arithmetic_v<T>)
+          res = this_test.check_eq(tmp, test::approx{obj});
+        else
+          res = this_test.check_eq(tmp, obj);
+      }
+      if (!res)
+        tstlog::debug("rejected input: {}", input);
+      return res;
+    };
+    test_cases.emplace_back(std::move(f));
+  }
+
+  // Adds a test case that should fail.
+  template <class T>
+  void add_neg_test_case(std::string_view input) {
+    auto f = [input](json_pull_reader& reader) -> bool {
+      auto tmp = T{};
+      auto res = reader.load(input)    // index JSON
+                 && reader.apply(tmp); // deserialize object
+      test::runnable::current().check(!res);
+      if (res) {
+        tstlog::error("got unexpected output: {}", tmp);
+        return false;
+      }
+      return true;
+    };
+    test_cases.emplace_back(std::move(f));
+  }
+
+  template <class T, class... Ts>
+  std::vector<T> ls(Ts... xs) {
+    std::vector<T> result;
+    (result.emplace_back(std::move(xs)), ...);
+    return result;
+  }
+
+  template <class T>
+  using dict = dictionary<T>;
+
+  fixture();
+
+  std::vector<std::function<bool(json_pull_reader&)>> test_cases;
+};
+
+fixture::fixture() {
+  using i32_list = std::vector<int32_t>;
+  using str_list = std::vector<std::string>;
+  add_test_case(R"_(true)_", true);
+  add_test_case(R"_([true, false])_", ls<bool>(true, false));
+  add_test_case(R"_([1, 2, 3])_", ls<int32_t>(1, 2, 3));
+  add_test_case(R"_([[1, 2], [3], []])_",
+                ls<i32_list>(ls<int32_t>(1, 2), ls<int32_t>(3), ls<int32_t>()));
+  add_test_case(R"_([2.0, 4, 8.5])_", ls<double>(2.0, 4.0, 8.5));
+  add_test_case(R"_("hello \"world\"!")_", std::string{R"_(hello "world"!)_"});
+  add_test_case(R"_({"a": 1, "b": 2})_", pull_request{1, 2});
+  add_test_case(R"_({"b": 2, "a": 1})_", pull_request{1, 2});
+  add_test_case(R"_({"a": 1, "b": 2})_", dict<int>({{"a", 1}, {"b", 2}}));
+  add_test_case(R"_({"xs": ["x1", "x2"], "ys": ["y1", "y2"]})_",
+                dict<str_list>({{"xs", ls<std::string>("x1", "x2")},
+                                {"ys", ls<std::string>("y1", "y2")}}));
+  add_test_case(R"_([{"a": 1}, {}, {"b": 2, "c": 3}])_",
+                ls<dict<int>>(dict<int>({{"a", 1}}), dict<int>(),
+                              dict<int>({{"b", 2}, {"c", 3}})));
+  add_test_case(
+    R"_({"@type": "caf::message", "types": ["pull_request"], "values": [{"a": 1, "b": 2}]})_",
+    make_message(pull_request{1, 2}));
+  add_test_case(
+    R"_({"top-left":{"x":100,"y":200},"bottom-right":{"x":10,"y":20}})_",
+    pull_rectangle{{100, 200}, {10, 20}});
+  // Unknown members, including nested containers, are skipped.
+  add_test_case(R"_({"extra": {"xs": [[1], {"y": [2, {}]}]},
+                     "bottom-right": {"x": 10, "y": 20, "z": [30]},
+                     "top-left": {"y": 200, "x": 100}})_",
+                pull_rectangle{{100, 200}, {10, 20}});
+  add_test_case(R"_(-9223372036854775808)_", int64_t{INT64_MIN});
+  add_test_case(R"_(18446744073709551615)_", uint64_t{UINT64_MAX});
+  add_neg_test_case<int8_t>(R"_(128)_");
+  add_neg_test_case<uint8_t>(R"_(-1)_");
+  add_neg_test_case<int64_t>(R"_(9223372036854775808)_");
+  add_test_case("\r\n{\r\n\"a\":\r\n1, \"b\"\r\n:\r\n2}\r\n",
+                pull_request{1, 2});
+  add_test_case(R"_("\u20AC\u2192\u221E")_", std::string{"€→∞"});
+  add_test_case(R"_("\ud834\udd1e")_", std::string{"𝄞"});
+  add_test_case(R"_({"\u0061": 1, "b": 2})_", pull_request{1, 2});
+  // Syntax errors are rejected when loading the input.
+  add_neg_test_case<std::string>(R"_("\ud900")_");
+  add_neg_test_case<std::string>(R"_("\u06c")_");
+  add_neg_test_case<i32_list>(R"_([1, 2,])_");
+  add_neg_test_case<i32_list>(R"_([1, 2)_");
+  add_neg_test_case<i32_list>(R"_([1, 2] 3)_");
+  add_neg_test_case<pull_request>(R"_({"a": 1 "b": 2})_");
+  // Type mismatches are rejected when deserializing.
+  add_neg_test_case<pull_request>(R"_({"a": "1", "b": 2})_");
+  add_neg_test_case<pull_request>(R"_({"a": 1})_");
+  add_neg_test_case<i32_list>(R"_({"a": 1})_");
+}
+
+} // namespace
+
+WITH_FIXTURE(fixture) {
+
+TEST("json baselines") {
+  size_t baseline_index = 0;
+  for (auto& f : test_cases) {
+    tstlog::debug("test case at index {}", baseline_index++);
+    json_pull_reader reader;
+    if (!f(reader))
+      if (auto& reason = reader.get_error(); reason.valid())
+        tstlog::debug("JSON reader stopped due to: {}", reason);
+  }
+}
+
+TEST("the pull reader selects variant types and skips null fields") {
+  widget_mapper mapper_instance;
+  json_pull_reader reader;
+  reader.mapper(&mapper_instance);
+  auto input = R"_({
+                     "@type": "pull_widget",
+                     "shape": {"center": {"x": 15, "y": 15}, "radius": 5},
+                     "label": null,
+                     "@shape-type": "circle",
+                     "color": "red"
+                   })_"sv;
+  require(reader.load(input));
+  pull_widget result;
+  check(reader.apply(result));
+  check_eq(result, pull_widget{"red", std::nullopt, pull_circle{{15, 15}, 5}});
+}
+
+TEST("strings without escape sequences point into the input") {
+  json_pull_reader reader;
+  auto input = R"_({"@type": "pull_request", "a": 1, "b": 2})_"sv;
+  require(reader.load(input));
+  std::string_view type_name;
+  require(reader.fetch_next_object_name(type_name));
+  check_eq(type_name, "pull_request");
+  check(type_name.data() >= input.data()
+        && type_name.data() < input.data() + input.size());
+}
+
+TEST("revert allows deserializing the same input again") {
+  json_pull_reader reader;
+  require(reader.load(R"_({"a": 1, "b": 2})_"sv));
+  pull_request x;
+  check(reader.apply(x));
+  check_eq(x, pull_request{1, 2});
+  reader.revert();
+  pull_request y;
+  check(reader.apply(y));
+  check_eq(y, pull_request{1, 2});
+  reader.reset();
+  pull_request z;
+  check(!reader.apply(z));
+}
+
+TEST("the pull reader and the DOM reader agree on the nesting limit") {
+  auto nested = [](size_t depth) {
+    return std::string(depth, '[') + std::string(depth, ']');
+  };
+  json_pull_reader reader;
+  check(reader.load(nested(128)));
+  check(!reader.load(nested(129)));
+  check_eq(reader.get_error(), pec::nested_too_deeply);
+}
+
+} // WITH_FIXTURE(fixture)
@@ -42,8 +42,14 @@ struct make_actor_util {
 
 namespace caf {
 
+/// Constructs a new actor of type `T` and its control block in `mem`.
+/// @param mem Points to an aligned memory block for the control block and the
+///            actor object.
+/// @param slab The slab that owns `mem` or `nullptr` if the control block
+///             shall release `mem` via `aligned_free`.
 template <class T, class R = infer_handle_from_class_t<T>, class... Ts>
-R make_actor(actor_id aid, node_id nid, actor_system* sys, Ts&&... xs) {
+R make_actor_at(void* mem, detail::actor_slab* slab, actor_id aid, node_id nid,
+                actor_system* sys, Ts&&... xs) {
   // Get the proper interface for the actor type.
   const meta::handler_list* iface;
   if constexpr (std::is_same_v<R, strong_actor_ptr>
@@ -55,10 +61,8 @@ R make_actor(actor_id aid, node_id nid, actor_system* sys, Ts&&... xs) {
     iface = &handlers_t::handlers;
   }
   using detail::make_actor_util;
-  // Allocate enough memory for the control block and the actor object.
   using traits = detail::control_block_traits<actor_control_block>;
-  auto* mem = traits::allocate<T>();
-  auto* ctrl = traits::construct_ctrl(mem, aid, nid, sys, iface);
+  auto* ctrl = traits::construct_ctrl(mem, aid, nid, sys, iface, slab);
 #ifdef CAF_ENABLE_TRACE_LOGGING
   if (auto* lptr = logger::current_logger();
       lptr && lptr->accepts(log::level::debug, CAF_LOG_FLOW_COMPONENT)) {
@@ -81,4 +85,13 @@ R make_actor(actor_id aid, node_id nid, actor_system* sys, Ts&&... xs) {
   return {ctrl, adopt_ref};
 }
 
+template <class T, class R = infer_handle_from_class_t<T>, class... Ts>
+R make_actor(actor_id aid, node_id nid, actor_system* sys, Ts&&... xs) {
+  // Allocate enough memory for the control block and the actor object.
+  using traits = detail::control_block_traits<actor_control_block>;
+  auto* mem = traits::allocate<T>();
+  return make_actor_at<T, R>(mem, nullptr, aid, std::move(nid), sys,
+                             std::forward<Ts>(xs)...);
+}
+
 } // namespace caf
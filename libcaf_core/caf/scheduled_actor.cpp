@@ -20,6 +20,7 @@
 #include "caf/detail/pretty_type_name.hpp"
 #include "caf/detail/private_thread.hpp"
 #include "caf/detail/sync_request_bouncer.hpp"
+#include "caf/event_based_actor.hpp"
 #include "caf/flow/observable_builder.hpp"
 #include "caf/format_to_error.hpp"
 #include "caf/internal/attachable_factory.hpp"
@@ -650,6 +651,12 @@ disposable scheduled_actor::delay_until(steady_time_point abs_time,
                           strong_actor_ptr{ctrl(), add_ref});
 }
 
+bool scheduled_actor::launch_worker(
+  shared_callback_ptr<void(flow::coordinator*)> init) {
+  home_system().spawn([init](event_based_actor* self) { (*init)(self); });
+  return true;
+}
+
 // -- message processing -------------------------------------------------------
 
 void scheduled_actor::add_awaited_response_handler(message_id response_id,
@@ -399,6 +399,10 @@ public:
 
   void watch(disposable what) override;
 
+  /// Spawns an event-based actor that calls `init` during its initialization.
+  bool
+  launch_worker(shared_callback_ptr<void(flow::coordinator*)> init) override;
+
   /// Lifts a statically typed stream into an @ref caf::flow::observable.
   /// @param what The input stream.
   /// @param buf_capacity Upper bound for caching inputs from the stream.
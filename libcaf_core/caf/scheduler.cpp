@@ -18,7 +18,9 @@
 #include "caf/resumable.hpp"
 #include "caf/thread_owner.hpp"
 
+#include <algorithm>
 #include <condition_variable>
+#include <list>
 #include <memory>
 #include <random>
 #include <thread>
@@ -133,6 +135,16 @@ public:
     data_.queue.prepend(job.release());
   }
 
+  // Appends all jobs to the queue while acquiring its lock only once.
+  void append(std::span<resumable_ptr> jobs) {
+    std::list<resumable*> items;
+    for (auto& job : jobs) {
+      CAF_ASSERT(job != nullptr);
+      items.push_back(job.release());
+    }
+    data_.queue.append(std::move(items));
+  }
+
   size_t id() const {
     return id_;
   }
@@ -252,6 +264,19 @@ public:
     w->schedule(std::move(job), resumable::default_event_id);
   }
 
+  void schedule_batch(std::span<resumable_ptr> jobs, uint64_t) override {
+    // Split the jobs into one contiguous chunk per worker. Each worker then
+    // receives its chunk with a single queue operation.
+    if (jobs.empty())
+      return;
+    auto chunk_size = (jobs.size() + num_workers_ - 1) / num_workers_;
+    auto offset = next_worker++;
+    for (size_t pos = 0; pos < jobs.size(); pos += chunk_size) {
+      auto n = std::min(chunk_size, jobs.size() - pos);
+      worker_by_id(offset++ % num_workers_)->append(jobs.subspan(pos, n));
+    }
+  }
+
   void delay(resumable_ptr what, uint64_t) override {
     schedule(std::move(what), resumable::default_event_id);
   }
@@ -460,6 +485,17 @@ public:
     cv.notify_one();
   }
 
+  void schedule_batch(std::span<resumable_ptr> jobs, uint64_t) override {
+    if (jobs.empty())
+      return;
+    queue_type l;
+    for (auto& job : jobs)
+      l.emplace_back(std::move(job));
+    std::unique_lock<std::mutex> guard(lock);
+    queue.splice(queue.end(), l);
+    cv.notify_all();
+  }
+
   void delay(resumable_ptr what, uint64_t) override {
     schedule(std::move(what), resumable::default_event_id);
   }
@@ -596,4 +632,12 @@ scheduler::~scheduler() {
   // nop
 }
 
+// -- scheduling ---------------------------------------------------------------
+
+void scheduler::schedule_batch(std::span<resumable_ptr> jobs,
+                               uint64_t event_id) {
+  for (auto& job : jobs)
+    schedule(std::move(job), event_id);
+}
+
 } // namespace caf
@@ -9,6 +9,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <span>
 
 namespace caf {
 
@@ -29,6 +30,12 @@ public:
   /// @threadsafe
   virtual void schedule(resumable_ptr what, uint64_t event_id) = 0;
 
+  /// Schedules all @p jobs to run at some point in the future. The default
+  /// implementation calls `schedule` for each job. Implementations may
+  /// override this function to enqueue multiple jobs at once.
+  /// @threadsafe
+  virtual void schedule_batch(std::span<resumable_ptr> jobs, uint64_t event_id);
+
   /// Delay the next execution of @p what. Unlike `schedule`, this function is
   /// not thread-safe and must be called only from the scheduler thread that is
   /// currently running.
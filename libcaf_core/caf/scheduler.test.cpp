@@ -113,6 +113,44 @@ OUTLINE("scheduling resumables") {
   )";
 }
 
+OUTLINE("scheduling resumables in batches") {
+  GIVEN("an actor system using the work <sched> scheduler") {
+    auto sched = block_parameters<std::string>();
+    actor_system_config cfg;
+    cfg.set("caf.scheduler.max-throughput", 5);
+    cfg.set("caf.scheduler.max-threads", 2);
+    cfg.set("caf.scheduler.policy", sched);
+    WHEN("scheduling a batch of resumables") {
+      auto sys = std::make_unique<actor_system>(cfg);
+      auto testees = std::vector<intrusive_ptr<testee>>{};
+      auto jobs = std::vector<resumable_ptr>{};
+      auto rendezvous = std::make_shared<std::latch>(26);
+      for (int i = 0; i < 25; i++) {
+        testees.emplace_back(make_counted<testee>(rendezvous));
+        jobs.emplace_back(testees.back());
+      }
+      sys->scheduler().schedule_batch(jobs, resumable::default_event_id);
+      THEN("expect the resumables to be executed until done") {
+        rendezvous->count_down();
+        rendezvous->wait();
+        for (const auto& ptr : testees) {
+          check_eq(ptr->runs, 10u);
+        }
+      }
+      AND_THEN("the scheduler releases the ref when done") {
+        sys = nullptr;
+        for (const auto& ptr : testees)
+          check_eq(ptr->strong_reference_count(), 1u);
+      }
+    }
+  }
+  EXAMPLES = R"(
+    |    sched    |
+    | sharing     |
+    | stealing    |
+  )";
+}
+
 class awaiting_testee : public resumable {
 public:
   explicit awaiting_testee(std::shared_ptr<std::latch> latch_handle)
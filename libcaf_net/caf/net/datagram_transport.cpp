@@ -0,0 +1,374 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/net/datagram_transport.hpp"
+
+#include "caf/net/multiplexer.hpp"
+#include "caf/net/socket_manager.hpp"
+
+#include "caf/async/consumer_adapter.hpp"
+#include "caf/async/producer_adapter.hpp"
+#include "caf/byte_buffer.hpp"
+#include "caf/log/net.hpp"
+#include "caf/sec.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace caf::net {
+
+namespace {
+
+/// Maximum payload of a single UDP datagram.
+constexpr size_t max_udp_payload = 65'507;
+
+/// Maximum number of segments that the OS accepts for a single GSO send.
+constexpr size_t max_gso_segments = 64;
+
+class datagram_transport_impl : public datagram_transport {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using consumer_type = async::consumer_adapter<udp::datagram>;
+
+  using producer_type = async::producer_adapter<udp::datagram>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  datagram_transport_impl(udp_datagram_socket fd, pull_t pull, push_t push,
+                          const config& cfg)
+    : fd_(fd), pull_(std::move(pull)), push_(std::move(push)), cfg_(cfg) {
+    // nop
+  }
+
+  // -- implementation of socket_event_layer -----------------------------------
+
+  error start(socket_manager* owner) override {
+    parent_ = owner;
+    if (cfg_.max_batch_size == 0 || cfg_.max_datagram_size == 0) {
+      auto err = make_error(sec::invalid_argument,
+                            "datagram transport requires a positive batch "
+                            "size and datagram size");
+      abort(err);
+      return err;
+    }
+    if (cfg_.gro) {
+      if (auto err = allow_udp_gro(fd_, true)) {
+        log::net::debug("failed to enable UDP GRO: {}", err);
+        cfg_.gro = false;
+      }
+    }
+    if (cfg_.gso && !udp_gso_supported()) {
+      log::net::debug("UDP GSO is not available on this platform");
+      cfg_.gso = false;
+    }
+    // With GRO, the OS may coalesce up to 64 KB into a single read.
+    auto slot_size = cfg_.max_datagram_size;
+    if (cfg_.gro)
+      slot_size = std::max(slot_size, max_udp_payload);
+    read_buf_.resize(slot_size * cfg_.max_batch_size);
+    read_slots_.resize(cfg_.max_batch_size);
+    for (size_t i = 0; i < read_slots_.size(); ++i)
+      read_slots_[i].buf = byte_span{read_buf_.data() + i * slot_size,
+                                     slot_size};
+    // Connect to the buffers of the application.
+    auto ctx = async::execution_context_ptr{owner->mpx_ptr(), add_ref};
+    auto do_wakeup = make_action([this] {
+      if (in_)
+        parent_->register_writing();
+    });
+    in_ = consumer_type::make(pull_.try_open(), ctx, std::move(do_wakeup));
+    if (!in_) {
+      auto err = make_error(sec::runtime_error, "datagram transport failed to "
+                                                "open the input resource");
+      abort(err);
+      return err;
+    }
+    auto do_resume = make_action([this] {
+      if (out_)
+        parent_->register_reading();
+    });
+    auto do_cancel = make_action([this] {
+      // The application no longer reads incoming datagrams.
+      out_ = nullptr;
+      parent_->deregister_reading();
+      shutdown_if_idle();
+    });
+    out_ = producer_type::make(push_.try_open(), ctx, std::move(do_resume),
+                               std::move(do_cancel));
+    if (!out_) {
+      auto err = make_error(sec::runtime_error, "datagram transport failed to "
+                                                "open the output resource");
+      abort(err);
+      return err;
+    }
+    // Keeps the manager alive while it is not registered for any event.
+    self_ref_ = owner->as_disposable();
+    parent_->register_reading();
+    return none;
+  }
+
+  socket handle() const override {
+    return fd_;
+  }
+
+  void handle_read_event() override {
+    auto lg = log::net::trace("socket = {}", fd_);
+    if (!out_) {
+      parent_->deregister_reading();
+      return;
+    }
+    auto res = read(fd_, std::span{read_slots_});
+    if (res < 0) {
+      if (!last_socket_error_is_temporary())
+        fail(make_error(sec::socket_operation_failed,
+                        last_socket_error_as_string()));
+      return;
+    }
+    received_.clear();
+    for (auto& slot : std::span{read_slots_}.first(static_cast<size_t>(res))) {
+      if (slot.truncated || slot.size > cfg_.max_datagram_size) {
+        log::net::warning("dropped a datagram from {} that exceeds the maximum "
+                          "datagram size",
+                          slot.source);
+        continue;
+      }
+      auto bytes = const_byte_span{slot.buf.data(), slot.size};
+      if (slot.segment_size == 0) {
+        received_.push_back(udp::datagram{slot.source, chunk{bytes}});
+        continue;
+      }
+      // Split coalesced datagrams.
+      while (!bytes.empty()) {
+        auto segment = bytes.first(std::min(slot.segment_size, bytes.size()));
+        received_.push_back(udp::datagram{slot.source, chunk{segment}});
+        bytes = bytes.subspan(segment.size());
+      }
+    }
+    if (received_.empty())
+      return;
+    if (out_.push(std::span<const udp::datagram>{received_}) == 0)
+      parent_->deregister_reading();
+  }
+
+  void handle_write_event() override {
+    auto lg = log::net::trace("socket = {}", fd_);
+    if (pending_.empty())
+      pull_pending();
+    if (pending_.empty()) {
+      parent_->deregister_writing();
+      shutdown_if_idle();
+      return;
+    }
+    prepare_write_slots();
+    auto res = write(fd_, std::span<const udp_write_slot>{write_slots_});
+    if (res < 0) {
+      if (last_socket_error_is_temporary())
+        return;
+      auto reason = last_socket_error_as_string();
+      auto uses_gso = [](const udp_write_slot& slot) {
+        return slot.segment_size > 0;
+      };
+      if (std::any_of(write_slots_.begin(), write_slots_.end(), uses_gso)) {
+        // Older kernels or NICs may reject GSO. Try again without it.
+        log::net::warning("disable UDP GSO after a failed write: {}", reason);
+        cfg_.gso = false;
+        return;
+      }
+      // UDP gives no delivery guarantees. Hence, we drop the datagram that we
+      // failed to send instead of closing the socket.
+      log::net::warning("failed to send a datagram to {}: {}",
+                        write_slots_.front().destination, reason);
+      res = 1;
+    }
+    auto first = slot_sizes_.begin();
+    auto sent = std::accumulate(first, first + res, size_t{0});
+    pending_.erase(pending_.begin(),
+                   pending_.begin() + static_cast<ptrdiff_t>(sent));
+    if (pending_.empty() && (!in_ || !in_.has_consumer_event())) {
+      parent_->deregister_writing();
+      shutdown_if_idle();
+    }
+  }
+
+  void abort(const error& reason) override {
+    auto lg = log::net::trace("reason = {}", reason);
+    if (out_) {
+      if (reason.empty() || reason == sec::disposed)
+        out_.close();
+      else
+        out_.abort(reason);
+      out_ = nullptr;
+    } else if (push_) {
+      push_.abort(reason);
+    }
+    if (in_) {
+      in_.cancel();
+      in_ = nullptr;
+    } else if (pull_) {
+      pull_.cancel();
+    }
+    pending_.clear();
+    self_ref_ = nullptr;
+  }
+
+private:
+  // -- utility functions ------------------------------------------------------
+
+  /// Reads up to one batch of outgoing datagrams from the application.
+  void pull_pending() {
+    udp::datagram tmp;
+    while (in_ && pending_.size() < cfg_.max_batch_size) {
+      switch (in_.pull(async::delay_errors, tmp)) {
+        case async::read_result::ok:
+          pending_.push_back(std::move(tmp));
+          break;
+        case async::read_result::stop:
+          // The application no longer sends datagrams.
+          in_ = nullptr;
+          break;
+        case async::read_result::abort: {
+          auto reason = in_.abort_reason();
+          in_ = nullptr;
+          fail(reason);
+          return;
+        }
+        default: // try later
+          return;
+      }
+    }
+  }
+
+  /// Groups the pending datagrams into write slots. With GSO, consecutive
+  /// datagrams for the same receiver share a slot if they have the same size
+  /// (only the last datagram of a slot may be shorter).
+  void prepare_write_slots() {
+    write_slots_.clear();
+    slot_sizes_.clear();
+    auto run_length = [this](size_t first) {
+      auto& head = pending_[first];
+      auto segment_size = head.payload.size();
+      if (!cfg_.gso || segment_size == 0)
+        return size_t{1};
+      auto total = segment_size;
+      auto len = size_t{1};
+      while (first + len < pending_.size() && len < max_gso_segments) {
+        auto& next = pending_[first + len];
+        auto size = next.payload.size();
+        if (next.endpoint != head.endpoint || size == 0 || size > segment_size
+            || total + size > max_udp_payload)
+          break;
+        total += size;
+        ++len;
+        if (size < segment_size)
+          break;
+      }
+      return len;
+    };
+    // Compute all runs first to allocate the GSO buffer only once. Otherwise,
+    // growing the buffer would invalidate the spans in our slots.
+    auto gso_bytes = size_t{0};
+    for (size_t i = 0; i < pending_.size();) {
+      auto len = run_length(i);
+      if (len > 1)
+        for (size_t j = i; j < i + len; ++j)
+          gso_bytes += pending_[j].payload.size();
+      slot_sizes_.push_back(len);
+      i += len;
+    }
+    gso_buf_.clear();
+    gso_buf_.reserve(gso_bytes);
+    auto i = size_t{0};
+    for (auto len : slot_sizes_) {
+      auto& head = pending_[i];
+      if (len == 1) {
+        write_slots_.push_back(
+          udp_write_slot{head.payload.bytes(), 0, head.endpoint});
+      } else {
+        auto offset = gso_buf_.size();
+        for (size_t j = i; j < i + len; ++j) {
+          auto bytes = pending_[j].payload.bytes();
+          gso_buf_.insert(gso_buf_.end(), bytes.begin(), bytes.end());
+        }
+        auto bytes = const_byte_span{gso_buf_.data() + offset,
+                                     gso_buf_.size() - offset};
+        write_slots_.push_back(
+          udp_write_slot{bytes, head.payload.size(), head.endpoint});
+      }
+      i += len;
+    }
+  }
+
+  /// Shuts down the manager after the application closed both directions.
+  void shutdown_if_idle() {
+    if (!in_ && !out_ && pending_.empty()) {
+      abort(error{});
+      parent_->shutdown();
+    }
+  }
+
+  void fail(const error& reason) {
+    log::net::debug("datagram transport failed with reason: {}", reason);
+    abort(reason);
+    parent_->deregister();
+    parent_->shutdown();
+  }
+
+  // -- member variables -------------------------------------------------------
+
+  /// The managed socket.
+  udp_datagram_socket fd_;
+
+  /// Stores the resources until we open them in `start`.
+  pull_t pull_;
+  push_t push_;
+
+  /// Configures batch sizes and offloading.
+  config cfg_;
+
+  /// Points to the manager that owns this transport.
+  socket_manager* parent_ = nullptr;
+
+  /// The output of the application, i.e., datagrams for the socket.
+  consumer_type in_;
+
+  /// The input of the application, i.e., datagrams from the socket.
+  producer_type out_;
+
+  /// Keeps the manager alive while it is not registered for any event.
+  disposable self_ref_;
+
+  /// Provides the storage for `read_slots_`.
+  byte_buffer read_buf_;
+
+  /// Receives datagrams in batches.
+  std::vector<udp_read_slot> read_slots_;
+
+  /// Stores the datagrams of a single read operation for the application.
+  std::vector<udp::datagram> received_;
+
+  /// Stores outgoing datagrams that we have not sent yet.
+  std::vector<udp::datagram> pending_;
+
+  /// Describes the payload for a single batched write operation.
+  std::vector<udp_write_slot> write_slots_;
+
+  /// Stores how many pending datagrams each write slot contains.
+  std::vector<size_t> slot_sizes_;
+
+  /// Stores the payload for slots that combine multiple datagrams.
+  byte_buffer gso_buf_;
+};
+
+} // namespace
+
+std::unique_ptr<datagram_transport>
+datagram_transport::make(udp_datagram_socket fd, pull_t pull, push_t push,
+                         const config& cfg) {
+  return std::make_unique<datagram_transport_impl>(fd, std::move(pull),
+                                                   std::move(push), cfg);
+}
+
+} // namespace caf::net
@@ -0,0 +1,61 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/net/fwd.hpp"
+#include "caf/net/socket_event_layer.hpp"
+#include "caf/net/udp/datagram.hpp"
+#include "caf/net/udp_datagram_socket.hpp"
+
+#include "caf/async/spsc_buffer.hpp"
+#include "caf/defaults.hpp"
+#include "caf/detail/net_export.hpp"
+#include "caf/fwd.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace caf::net {
+
+/// A transport layer for sending and receiving datagrams in batches. The
+/// transport connects a UDP socket to a pair of SPSC buffers: it pushes each
+/// received datagram to the application and sends each datagram that the
+/// application produces.
+class CAF_NET_EXPORT datagram_transport : public socket_event_layer {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// Consumes the outgoing datagrams of the application.
+  using pull_t = async::consumer_resource<udp::datagram>;
+
+  /// Produces the incoming datagrams for the application.
+  using push_t = async::producer_resource<udp::datagram>;
+
+  /// Configures the transport.
+  struct config {
+    /// Maximum number of datagrams that the transport reads or writes with a
+    /// single system call.
+    size_t max_batch_size = defaults::net::udp_max_batch_size;
+
+    /// Maximum size of a single datagram. The transport drops incoming
+    /// datagrams that exceed this size.
+    size_t max_datagram_size = defaults::net::udp_max_datagram_size;
+
+    /// Enables generic segmentation offload (GSO) if available, i.e., lets the
+    /// OS split consecutive datagrams of equal size for the same receiver.
+    bool gso = false;
+
+    /// Enables generic receive offload (GRO) if available, i.e., lets the OS
+    /// coalesce consecutive datagrams from the same sender.
+    bool gro = false;
+  };
+
+  // -- factories --------------------------------------------------------------
+
+  static std::unique_ptr<datagram_transport>
+  make(udp_datagram_socket fd, pull_t pull, push_t push, const config& cfg);
+};
+
+} // namespace caf::net
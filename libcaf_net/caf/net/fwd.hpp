@@ -15,9 +15,6 @@ namespace caf::net {
 
 // -- templates ----------------------------------------------------------------
 
-template <class Factory>
-class datagram_transport;
-
 template <class... Sigs>
 class typed_actor_shell;
 
@@ -28,6 +25,7 @@ class typed_actor_shell_ptr;
 
 class actor_shell;
 class actor_shell_ptr;
+class datagram_transport;
 class middleman;
 class multiplexer;
 class socket_event_layer;
@@ -103,6 +101,14 @@ using frame = caf::chunk;
 
 } // namespace caf::net::lp
 
+namespace caf::net::udp {
+
+class with_t;
+
+struct datagram;
+
+} // namespace caf::net::udp
+
 namespace caf::net::web_socket {
 
 class client;
@@ -22,6 +22,20 @@ auto native(connection::impl* ptr) {
   return reinterpret_cast<SSL*>(ptr);
 }
 
+void free_native(connection::impl* ptr) {
+  auto ssl = native(ptr);
+  if (ssl == nullptr)
+    return;
+  // Our transports close the socket without sending a close_notify alert.
+  // OpenSSL considers the session of such a connection as broken and removes
+  // it from the session cache unless we mark the shutdown as complete. Fatal
+  // errors still invalidate the session, because OpenSSL removes the session
+  // when sending or receiving a fatal alert.
+  if (SSL_is_init_finished(ssl))
+    SSL_set_shutdown(ssl, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+  SSL_free(ssl);
+}
+
 } // namespace
 
 // -- constructors, destructors, and assignment operators ----------------------
@@ -32,14 +46,14 @@ connection::connection(connection&& other) {
 }
 
 connection& connection::operator=(connection&& other) {
-  SSL_free(native(pimpl_));
+  free_native(pimpl_);
   pimpl_ = other.pimpl_;
   other.pimpl_ = nullptr;
   return *this;
 }
 
 connection::~connection() {
-  SSL_free(native(pimpl_)); // Already checks for NULL.
+  free_native(pimpl_);
 }
 
 // -- native handles -----------------------------------------------------------
@@ -90,6 +104,12 @@ bool connection::hostname(const char* hostname) noexcept {
   return SSL_set1_host(native(pimpl_), hostname);
 }
 
+// -- session resumption -------------------------------------------------------
+
+bool connection::session_reused() const noexcept {
+  return pimpl_ != nullptr && SSL_session_reused(native(pimpl_)) == 1;
+}
+
 // -- connecting and teardown --------------------------------------------------
 
 ptrdiff_t connection::connect() {
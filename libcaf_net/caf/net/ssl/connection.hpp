@@ -69,6 +69,12 @@ public:
   /// Must be called before connect().
   [[nodiscard]] bool hostname(const char* hostname) noexcept;
 
+  // -- session resumption -----------------------------------------------------
+
+  /// Checks whether the handshake resumed a previous session instead of
+  /// negotiating a new one.
+  [[nodiscard]] bool session_reused() const noexcept;
+
   // -- connecting and teardown ------------------------------------------------
 
   /// Performs the client-side TLS/SSL handshake after connection to the server.
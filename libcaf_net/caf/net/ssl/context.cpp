@@ -9,9 +9,26 @@
 #include "caf/config.hpp"
 #include "caf/expected.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 CAF_PUSH_WARNINGS
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
 #include <openssl/ssl.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#  include <openssl/core_names.h>
+#else
+#  include <openssl/hmac.h>
+#endif
 CAF_POP_WARNINGS
 
 namespace caf::net::ssl {
@@ -22,6 +39,236 @@ auto native(context::impl* ptr) {
   return reinterpret_cast<SSL_CTX*>(ptr);
 }
 
+/// Encrypts and authenticates session tickets.
+struct ticket_key {
+  using time_point = std::chrono::steady_clock::time_point;
+
+  std::array<unsigned char, 16> name;
+  std::array<unsigned char, 32> aes_key;
+  std::array<unsigned char, 32> hmac_key;
+  time_point created;
+};
+
+/// Session state that the SSL callbacks access. Unlike the `user_data` of a
+/// context, the state lives as long as the native context, because
+/// connections may outlive the context object that created them.
+struct session_state {
+  using time_point = ticket_key::time_point;
+
+  struct cached_session {
+    SSL_SESSION* ptr;
+    uint64_t last_used;
+  };
+
+  ~session_state() {
+    for (auto& [host, entry] : client_sessions)
+      SSL_SESSION_free(entry.ptr);
+  }
+
+  /// Generates a new key for session tickets if the current key is older than
+  /// the rotation interval and drops keys that may no longer decrypt tickets.
+  /// @pre `mtx` is locked
+  bool rotate_ticket_keys(time_point now) {
+    if (ticket_keys.empty() || now - ticket_keys.front().created >= rotation) {
+      ticket_key key;
+      if (RAND_bytes(key.name.data(), static_cast<int>(key.name.size())) != 1
+          || RAND_bytes(key.aes_key.data(),
+                        static_cast<int>(key.aes_key.size()))
+               != 1
+          || RAND_bytes(key.hmac_key.data(),
+                        static_cast<int>(key.hmac_key.size()))
+               != 1)
+        return false;
+      key.created = now;
+      ticket_keys.insert(ticket_keys.begin(), key);
+    }
+    // Tickets remain valid for one more interval after rotating their key.
+    auto expired = [now, max_age = 2 * rotation](const ticket_key& key) {
+      return now - key.created >= max_age;
+    };
+    ticket_keys.erase(std::remove_if(ticket_keys.begin() + 1,
+                                     ticket_keys.end(), expired),
+                      ticket_keys.end());
+    return true;
+  }
+
+  /// Stores `sess` as the most recent session for `host`, taking ownership of
+  /// `sess`.
+  /// @pre `mtx` is locked
+  void store_session(const std::string& host, SSL_SESSION* sess) {
+    auto stamp = ++clock;
+    if (auto i = client_sessions.find(host); i != client_sessions.end()) {
+      SSL_SESSION_free(i->second.ptr);
+      i->second = cached_session{sess, stamp};
+      return;
+    }
+    if (client_sessions.size() >= max_hosts) {
+      auto lru = std::min_element(client_sessions.begin(),
+                                  client_sessions.end(),
+                                  [](const auto& x, const auto& y) {
+                                    return x.second.last_used
+                                           < y.second.last_used;
+                                  });
+      SSL_SESSION_free(lru->second.ptr);
+      client_sessions.erase(lru);
+    }
+    client_sessions.emplace(host, cached_session{sess, stamp});
+  }
+
+  /// Counts full handshakes.
+  std::atomic<uint64_t> full_handshakes = 0;
+
+  /// Counts resumed handshakes.
+  std::atomic<uint64_t> resumed_handshakes = 0;
+
+  /// Protects the keys and the client-side session cache. SSL callbacks may
+  /// run concurrently for different connections.
+  std::mutex mtx;
+
+  /// The keys for session tickets, ordered from newest to oldest.
+  std::vector<ticket_key> ticket_keys;
+
+  /// The interval for generating a new ticket key.
+  timespan rotation{0};
+
+  /// Maps host names to their most recent session.
+  std::unordered_map<std::string, cached_session> client_sessions;
+
+  /// The maximum size of `client_sessions`.
+  size_t max_hosts = 0;
+
+  /// Logical clock for evicting the least recently used host.
+  uint64_t clock = 0;
+};
+
+void free_session_state(void*, void* ptr, CRYPTO_EX_DATA*, int, long,
+                        void*) {
+  delete static_cast<session_state*>(ptr);
+}
+
+void free_session_host(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+  delete static_cast<std::string*>(ptr);
+}
+
+/// Returns the index for storing a `session_state` in an `SSL_CTX`.
+int session_state_index() {
+  static int result = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr,
+                                               free_session_state);
+  return result;
+}
+
+/// Returns the index for storing the host name of a client connection for the
+/// client-side session cache.
+int session_host_index() {
+  static int result = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr,
+                                           free_session_host);
+  return result;
+}
+
+session_state* get_session_state(const SSL_CTX* ctx) {
+  if (ctx == nullptr)
+    return nullptr;
+  return static_cast<session_state*>(
+    SSL_CTX_get_ex_data(ctx, session_state_index()));
+}
+
+void count_handshakes(const SSL* ssl, int where, int) {
+  if ((where & SSL_CB_HANDSHAKE_DONE) == 0)
+    return;
+  if (auto* state = get_session_state(SSL_get_SSL_CTX(ssl))) {
+    if (SSL_session_reused(const_cast<SSL*>(ssl)) == 1)
+      ++state->resumed_handshakes;
+    else
+      ++state->full_handshakes;
+  }
+}
+
+/// Attaches a new `session_state` to `ctx` unless present.
+void init_session_state(SSL_CTX* ctx) {
+  if (ctx == nullptr || get_session_state(ctx) != nullptr)
+    return;
+  SSL_CTX_set_ex_data(ctx, session_state_index(), new session_state);
+  SSL_CTX_set_info_callback(ctx, count_handshakes);
+}
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+using ticket_mac_ctx = EVP_MAC_CTX;
+
+int init_ticket_mac(ticket_mac_ctx* hctx, ticket_key& key) {
+  OSSL_PARAM params[] = {
+    OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, key.hmac_key.data(),
+                                      key.hmac_key.size()),
+    OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
+                                     const_cast<char*>("sha256"), 0),
+    OSSL_PARAM_construct_end(),
+  };
+  return EVP_MAC_CTX_set_params(hctx, params);
+}
+#else
+using ticket_mac_ctx = HMAC_CTX;
+
+int init_ticket_mac(ticket_mac_ctx* hctx, ticket_key& key) {
+  return HMAC_Init_ex(hctx, key.hmac_key.data(),
+                      static_cast<int>(key.hmac_key.size()), EVP_sha256(),
+                      nullptr);
+}
+#endif
+
+int ticket_key_callback(SSL* ssl, unsigned char* key_name, unsigned char* iv,
+                        EVP_CIPHER_CTX* cctx, ticket_mac_ctx* hctx, int enc) {
+  auto* state = get_session_state(SSL_get_SSL_CTX(ssl));
+  if (state == nullptr)
+    return -1;
+  std::unique_lock guard{state->mtx};
+  if (!state->rotate_ticket_keys(std::chrono::steady_clock::now()))
+    return -1;
+  if (enc == 1) {
+    // Issue a new ticket with the current key.
+    auto& key = state->ticket_keys.front();
+    auto iv_len = EVP_CIPHER_iv_length(EVP_aes_256_cbc());
+    if (RAND_bytes(iv, iv_len) != 1)
+      return -1;
+    memcpy(key_name, key.name.data(), key.name.size());
+    if (EVP_EncryptInit_ex(cctx, EVP_aes_256_cbc(), nullptr,
+                           key.aes_key.data(), iv)
+          != 1
+        || init_ticket_mac(hctx, key) != 1)
+      return -1;
+    return 1;
+  }
+  // Decrypt a ticket from the client.
+  auto matches = [key_name](const ticket_key& key) {
+    return memcmp(key.name.data(), key_name, key.name.size()) == 0;
+  };
+  auto i = std::find_if(state->ticket_keys.begin(), state->ticket_keys.end(),
+                        matches);
+  if (i == state->ticket_keys.end()) {
+    // Unknown or expired key: fall back to a full handshake.
+    return 0;
+  }
+  if (EVP_DecryptInit_ex(cctx, EVP_aes_256_cbc(), nullptr, i->aes_key.data(),
+                         iv)
+        != 1
+      || init_ticket_mac(hctx, *i) != 1)
+    return -1;
+  // Ask OpenSSL to renew tickets that use an old key.
+  return i == state->ticket_keys.begin() ? 1 : 2;
+}
+
+int store_client_session(SSL* ssl, SSL_SESSION* sess) {
+  auto* host = static_cast<std::string*>(
+    SSL_get_ex_data(ssl, session_host_index()));
+  auto* state = get_session_state(SSL_get_SSL_CTX(ssl));
+  if (host == nullptr || state == nullptr || SSL_SESSION_is_resumable(sess) != 1)
+    return 0;
+  std::unique_lock guard{state->mtx};
+  if (state->max_hosts == 0)
+    return 0;
+  state->store_session(*host, sess);
+  // Returning 1 tells OpenSSL that we took ownership of the session.
+  return 1;
+}
+
 } // namespace
 
 // -- member types -------------------------------------------------------------
@@ -75,6 +322,7 @@ std::pair<SSL_CTX*, const char*> make_ctx(const SSL_METHOD* method,
   auto ctx = SSL_CTX_new(method);
   if (!ctx)
     return {nullptr, "SSL_CTX_new returned null"};
+  init_session_state(ctx);
   // Avoid fallback to SSLv3.
   // Select the protocol versions in the configured range.
 #if OPENSSL_VERSION_NUMBER < 0x10100000L
@@ -216,9 +464,104 @@ void context::password_callback_impl(password::callback_ptr callback) {
   SSL_CTX_set_default_passwd_cb_userdata(ptr, data_->pw_callback.get());
 }
 
+// -- session resumption -------------------------------------------------------
+
+bool context::enable_session_cache(size_t capacity, timespan timeout) {
+  ERR_clear_error();
+  // OpenSSL requires a session ID context for resuming sessions on servers
+  // that verify client certificates.
+  static constexpr unsigned char sid_ctx[] = "caf.net.ssl";
+  auto ptr = native(pimpl_);
+  auto secs = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+  SSL_CTX_set_session_cache_mode(ptr, SSL_SESS_CACHE_SERVER);
+  SSL_CTX_sess_set_cache_size(ptr, static_cast<long>(capacity));
+  auto secs_or_1 = std::max(secs.count(), decltype(secs.count()){1});
+  SSL_CTX_set_timeout(ptr, static_cast<long>(secs_or_1));
+  return SSL_CTX_set_session_id_context(ptr, sid_ctx, sizeof(sid_ctx) - 1)
+         == 1;
+}
+
+bool context::enable_session_tickets(timespan rotation_interval) {
+  ERR_clear_error();
+  auto ptr = native(pimpl_);
+  auto* state = get_session_state(ptr);
+  if (state == nullptr || rotation_interval.count() <= 0)
+    return false;
+  {
+    std::unique_lock guard{state->mtx};
+    state->rotation = rotation_interval;
+    if (!state->rotate_ticket_keys(std::chrono::steady_clock::now()))
+      return false;
+  }
+  SSL_CTX_clear_options(ptr, SSL_OP_NO_TICKET);
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+  return SSL_CTX_set_tlsext_ticket_key_evp_cb(ptr, ticket_key_callback) == 1;
+#else
+  return SSL_CTX_set_tlsext_ticket_key_cb(ptr, ticket_key_callback) == 1;
+#endif
+}
+
+bool context::enable_session_reuse(size_t max_hosts) {
+  ERR_clear_error();
+  auto ptr = native(pimpl_);
+  auto* state = get_session_state(ptr);
+  if (state == nullptr || max_hosts == 0)
+    return false;
+  {
+    std::unique_lock guard{state->mtx};
+    state->max_hosts = max_hosts;
+  }
+  // We store sessions per host, so OpenSSL must not keep its own copy.
+  SSL_CTX_set_session_cache_mode(ptr, SSL_SESS_CACHE_CLIENT
+                                        | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+  SSL_CTX_sess_set_new_cb(ptr, store_client_session);
+  return true;
+}
+
+bool context::reuse_session(connection& conn, std::string_view host) {
+  auto* ssl = static_cast<SSL*>(conn.native_handle());
+  auto* state = get_session_state(native(pimpl_));
+  if (ssl == nullptr || state == nullptr || host.empty())
+    return false;
+  std::unique_lock guard{state->mtx};
+  if (state->max_hosts == 0)
+    return false;
+  auto key = std::string{host};
+  auto* old_key = SSL_get_ex_data(ssl, session_host_index());
+  SSL_set_ex_data(ssl, session_host_index(), new std::string{key});
+  delete static_cast<std::string*>(old_key);
+  auto i = state->client_sessions.find(key);
+  if (i == state->client_sessions.end())
+    return false;
+  auto* sess = i->second.ptr;
+  if (SSL_SESSION_is_resumable(sess) != 1) {
+    SSL_SESSION_free(sess);
+    state->client_sessions.erase(i);
+    return false;
+  }
+  auto result = SSL_set_session(ssl, sess) == 1;
+  if (SSL_SESSION_get_protocol_version(sess) == TLS1_3_VERSION) {
+    // TLS 1.3 tickets are meant for a single use. The server sends fresh
+    // tickets after the handshake.
+    SSL_SESSION_free(sess);
+    state->client_sessions.erase(i);
+  } else {
+    i->second.last_used = ++state->clock;
+  }
+  return result;
+}
+
+context::session_stats context::stats() const noexcept {
+  auto* state = get_session_state(native(pimpl_));
+  if (state == nullptr)
+    return {};
+  return {state->full_handshakes.load(), state->resumed_handshakes.load()};
+}
+
 // -- native handles -----------------------------------------------------------
 
 context context::from_native(void* native_handle) {
+  init_session_state(static_cast<SSL_CTX*>(native_handle));
   return context{static_cast<impl*>(native_handle)};
 }
 
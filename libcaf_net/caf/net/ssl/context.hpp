@@ -19,10 +19,13 @@
 #include "caf/detail/net_export.hpp"
 #include "caf/expected.hpp"
 #include "caf/format_to_unexpected.hpp"
+#include "caf/timespan.hpp"
 #include "caf/uri.hpp"
 
+#include <cstdint>
 #include <cstring>
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace caf::net::ssl {
@@ -42,6 +45,15 @@ public:
   /// Stores additional data provided by the user.
   struct user_data;
 
+  /// Counts the handshakes of all connections created from a context.
+  struct session_stats {
+    /// Number of handshakes that negotiated a new session.
+    uint64_t full_handshakes = 0;
+
+    /// Number of handshakes that resumed a previous session.
+    uint64_t resumed_handshakes = 0;
+  };
+
   // -- constructors, destructors, and assignment operators --------------------
 
   context() = delete;
@@ -141,6 +153,45 @@ public:
     password_callback(std::move(cb));
   }
 
+  // -- session resumption -----------------------------------------------------
+
+  /// Enables the server-side session cache. Clients that present the ID or a
+  /// stateful ticket of a cached session skip the full handshake.
+  /// @param capacity The maximum number of cached sessions.
+  /// @param timeout The lifetime of cached sessions.
+  /// @returns `true` on success, `false` otherwise and `last_error` can be used
+  ///          to retrieve a human-readable error representation.
+  /// @note For OpenSSL, calls @c SSL_CTX_set_session_cache_mode,
+  ///       @c SSL_CTX_sess_set_cache_size and @c SSL_CTX_set_timeout.
+  [[nodiscard]] bool enable_session_cache(size_t capacity, timespan timeout);
+
+  /// Enables stateless session tickets on the server. The context encrypts
+  /// tickets with a key that it replaces after each `rotation_interval`. A
+  /// ticket remains valid for one more interval after rotating its key and the
+  /// server then issues a fresh ticket on resumption.
+  /// @returns `true` on success, `false` otherwise and `last_error` can be used
+  ///          to retrieve a human-readable error representation.
+  /// @note For OpenSSL, calls @c SSL_CTX_set_tlsext_ticket_key_evp_cb.
+  [[nodiscard]] bool enable_session_tickets(timespan rotation_interval);
+
+  /// Enables the client-side session cache. The context stores the most recent
+  /// session per host and offers it to the server when calling
+  /// @ref reuse_session for a new connection to the same host.
+  /// @param max_hosts The maximum number of hosts with a cached session.
+  /// @returns `true` on success, `false` otherwise and `last_error` can be used
+  ///          to retrieve a human-readable error representation.
+  [[nodiscard]] bool enable_session_reuse(size_t max_hosts);
+
+  /// Offers the cached session for `host` (if any) on `conn` and associates
+  /// `conn` with `host` for storing new sessions. Must be called before
+  /// `connect()`. Does nothing unless @ref enable_session_reuse was called.
+  /// @returns `true` if `conn` offers a cached session, `false` otherwise.
+  bool reuse_session(connection& conn, std::string_view host);
+
+  /// Returns how many handshakes of connections from this context resumed a
+  /// previous session.
+  session_stats stats() const noexcept;
+
   // -- native handles ---------------------------------------------------------
 
   /// Reinterprets `native_handle` as the native implementation type and takes
@@ -576,6 +627,36 @@ inline auto use_sni_hostname(caf::uri uri) noexcept {
   };
 }
 
+/// Enables the server-side session cache.
+/// @param capacity The maximum number of cached sessions.
+/// @param timeout The lifetime of cached sessions.
+/// @returns a function object for chaining `expected<T>::and_then()`.
+inline auto enable_session_cache(size_t capacity, timespan timeout) {
+  return [capacity, timeout](context ctx) {
+    return detail::ssl_ctx_chain(ctx, "enable_session_cache failed",
+                                 ctx.enable_session_cache(capacity, timeout));
+  };
+}
+
+/// Enables stateless session tickets with keys that rotate after each
+/// `rotation_interval`.
+/// @returns a function object for chaining `expected<T>::and_then()`.
+inline auto enable_session_tickets(timespan rotation_interval) {
+  return [rotation_interval](context ctx) {
+    return detail::ssl_ctx_chain(ctx, "enable_session_tickets failed",
+                                 ctx.enable_session_tickets(rotation_interval));
+  };
+}
+
+/// Enables the client-side session cache for up to `max_hosts` hosts.
+/// @returns a function object for chaining `expected<T>::and_then()`.
+inline auto enable_session_reuse(size_t max_hosts) {
+  return [max_hosts](context ctx) {
+    return detail::ssl_ctx_chain(ctx, "enable_session_reuse failed",
+                                 ctx.enable_session_reuse(max_hosts));
+  };
+}
+
 /// Sets whether the hostname validation is turned on for all client
 /// connections.
 /// Note: The client connection will query this parameter and
@@ -0,0 +1,20 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/chunk.hpp"
+#include "caf/ip_endpoint.hpp"
+
+namespace caf::net::udp {
+
+/// A single datagram, i.e., a pair of remote endpoint and payload. For
+/// received datagrams, `endpoint` is the sender. For outgoing datagrams,
+/// `endpoint` is the receiver.
+struct datagram {
+  ip_endpoint endpoint;
+  chunk payload;
+};
+
+} // namespace caf::net::udp
@@ -0,0 +1,176 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/net/udp/with.hpp"
+
+#include "caf/net/datagram_transport.hpp"
+#include "caf/net/ip.hpp"
+#include "caf/net/middleman.hpp"
+#include "caf/net/multiplexer.hpp"
+#include "caf/net/socket_manager.hpp"
+#include "caf/net/udp_datagram_socket.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/ip_endpoint.hpp"
+#include "caf/ipv4_address.hpp"
+
+#include <variant>
+
+namespace caf::net::udp {
+
+class with_t::config_impl {
+public:
+  /// Configures a socket that we create lazily when starting the transport.
+  struct lazy {
+    uint16_t port;
+    std::string bind_address;
+    bool reuse_addr;
+  };
+
+  explicit config_impl(multiplexer* mpx) : mpx(mpx) {
+    // nop
+  }
+
+  ~config_impl() {
+    if (auto* fd = std::get_if<udp_datagram_socket>(&socket))
+      close(*fd);
+  }
+
+  expected<udp_datagram_socket> make_socket() {
+    if (auto* fd = std::get_if<udp_datagram_socket>(&socket)) {
+      auto result = *fd;
+      socket = none;
+      return result;
+    }
+    auto* cfg = std::get_if<lazy>(&socket);
+    if (cfg == nullptr)
+      return expected<udp_datagram_socket>{unexpect, sec::logic_error,
+                                           "no socket configured"};
+    auto ep = ip_endpoint{ipv4_address::any(), cfg->port};
+    if (!cfg->bind_address.empty()) {
+      auto addrs = ip::resolve(cfg->bind_address);
+      if (addrs.empty())
+        return expected<udp_datagram_socket>{unexpect, sec::cannot_open_port,
+                                             "unable to resolve the bind "
+                                             "address"};
+      ep.address(addrs.front());
+    }
+    return make_udp_datagram_socket(ep, cfg->reuse_addr);
+  }
+
+  void report(const error& what) {
+    if (on_error)
+      (*on_error)(what);
+  }
+
+  /// Stores the multiplexer for the socket manager.
+  multiplexer* mpx;
+
+  /// Stores an error that occurred while building the transport.
+  error err;
+
+  /// Stores the socket or the parameters for creating the socket.
+  std::variant<none_t, lazy, udp_datagram_socket> socket;
+
+  /// Configures the transport.
+  datagram_transport::config transport;
+
+  /// Reports errors to the user.
+  on_error_callback on_error;
+};
+
+// -- binding API --------------------------------------------------------------
+
+with_t::binding::binding(config_ptr&& cfg) noexcept : config_(std::move(cfg)) {
+  // nop
+}
+
+with_t::binding::~binding() {
+  // nop
+}
+
+with_t::binding&& with_t::binding::max_batch_size(size_t value) && {
+  config_->transport.max_batch_size = value;
+  return std::move(*this);
+}
+
+with_t::binding&& with_t::binding::max_datagram_size(size_t value) && {
+  config_->transport.max_datagram_size = value;
+  return std::move(*this);
+}
+
+with_t::binding&& with_t::binding::gso(bool value) && {
+  config_->transport.gso = value;
+  return std::move(*this);
+}
+
+with_t::binding&& with_t::binding::gro(bool value) && {
+  config_->transport.gro = value;
+  return std::move(*this);
+}
+
+expected<disposable> with_t::binding::do_start(pull_t pull, push_t push) {
+  auto& cfg = *config_;
+  auto fail = [&cfg, &pull, &push](error what) {
+    cfg.report(what);
+    pull.cancel();
+    push.abort(what);
+    return expected<disposable>{unexpect, std::move(what)};
+  };
+  // Handle an error that could've been created by the DSL during setup.
+  if (cfg.err.valid())
+    return fail(cfg.err);
+  auto fd = cfg.make_socket();
+  if (!fd)
+    return fail(std::move(fd.error()));
+  auto transport = datagram_transport::make(*fd, std::move(pull),
+                                            std::move(push), cfg.transport);
+  auto ptr = socket_manager::make(cfg.mpx, std::move(transport));
+  if (cfg.mpx->start(ptr))
+    return expected<disposable>{disposable{std::move(ptr)}};
+  auto err = make_error(sec::logic_error,
+                        "failed to register socket manager to net::multiplexer");
+  cfg.report(err);
+  return expected<disposable>{unexpect, std::move(err)};
+}
+
+// -- with API -----------------------------------------------------------------
+
+with_t with(multiplexer* mpx) {
+  return with_t{mpx};
+}
+
+with_t with(actor_system& sys) {
+  return with(sys.network_manager().mpx_ptr());
+}
+
+with_t::with_t(multiplexer* mpx) : config_(new config_impl(mpx)) {
+  // nop
+}
+
+with_t::with_t(with_t&&) noexcept = default;
+
+with_t& with_t::operator=(with_t&&) noexcept = default;
+
+with_t::~with_t() {
+  // nop
+}
+
+with_t::binding with_t::bind(uint16_t port, std::string bind_address,
+                             bool reuse_addr) && {
+  config_->socket = config_impl::lazy{port, std::move(bind_address),
+                                      reuse_addr};
+  return binding{std::move(config_)};
+}
+
+with_t::binding with_t::bind(udp_datagram_socket fd) && {
+  config_->socket = fd;
+  return binding{std::move(config_)};
+}
+
+void with_t::set_on_error(on_error_callback ptr) {
+  config_->on_error = std::move(ptr);
+}
+
+} // namespace caf::net::udp
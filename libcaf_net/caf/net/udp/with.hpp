@@ -0,0 +1,148 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/net/fwd.hpp"
+#include "caf/net/udp/datagram.hpp"
+
+#include "caf/async/spsc_buffer.hpp"
+#include "caf/callback.hpp"
+#include "caf/detail/net_export.hpp"
+#include "caf/disposable.hpp"
+#include "caf/expected.hpp"
+#include "caf/fwd.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace caf::net::udp {
+
+/// Entry point for the `with(...)` DSL.
+with_t CAF_NET_EXPORT with(multiplexer* mpx);
+
+/// Entry point for the `with(...)` DSL.
+with_t CAF_NET_EXPORT with(actor_system& sys);
+
+/// Factory for creating UDP sockets that exchange datagrams with flows.
+class CAF_NET_EXPORT with_t {
+public:
+  // -- nested types -----------------------------------------------------------
+
+  class config_impl;
+
+  using config_ptr = std::unique_ptr<config_impl>;
+
+  /// Factory for starting a datagram transport on a local endpoint.
+  class CAF_NET_EXPORT binding {
+  public:
+    friend class with_t;
+
+    /// Consumes the datagrams that the application sends.
+    using pull_t = async::consumer_resource<datagram>;
+
+    /// Produces the datagrams that the application receives.
+    using push_t = async::producer_resource<datagram>;
+
+    ~binding();
+
+    /// Sets the maximum number of datagrams per system call.
+    [[nodiscard]] binding&& max_batch_size(size_t value) &&;
+
+    /// Sets the maximum size of incoming datagrams.
+    [[nodiscard]] binding&& max_datagram_size(size_t value) &&;
+
+    /// Enables or disables generic segmentation offload for sending.
+    [[nodiscard]] binding&& gso(bool value) &&;
+
+    /// Enables or disables generic receive offload for receiving.
+    [[nodiscard]] binding&& gro(bool value) &&;
+
+    /// Starts reading and writing datagrams on the socket.
+    /// @param on_start The callback to invoke after the transport has started.
+    ///                 Receives a consumer resource for incoming datagrams and
+    ///                 a producer resource for outgoing datagrams.
+    /// @returns On success, a handle to stop the transport. On failure, an
+    ///          error.
+    /// @note The `on_start` callback is only invoked if the transport started
+    ///       successfully.
+    template <class OnStart>
+    [[nodiscard]] expected<disposable> start(OnStart on_start) && {
+      using app_pull_t = async::consumer_resource<datagram>;
+      using app_push_t = async::producer_resource<datagram>;
+      static_assert(std::is_invocable_v<OnStart, app_pull_t, app_push_t>);
+      // Create socket-to-application and application-to-socket buffers.
+      auto [s2a_pull, s2a_push] = async::make_spsc_buffer_resource<datagram>();
+      auto [a2s_pull, a2s_push] = async::make_spsc_buffer_resource<datagram>();
+      auto res = do_start(std::move(a2s_pull), std::move(s2a_push));
+      if (res) {
+        on_start(std::move(s2a_pull), std::move(a2s_push));
+      }
+      return res;
+    }
+
+    /// Starts reading and writing datagrams on the socket with custom buffers.
+    /// @returns On success, a handle to stop the transport. On failure, an
+    ///          error.
+    [[nodiscard]] expected<disposable> start(pull_t pull, push_t push) && {
+      return do_start(std::move(pull), std::move(push));
+    }
+
+  private:
+    explicit binding(config_ptr&& cfg) noexcept;
+
+    expected<disposable> do_start(pull_t pull, push_t push);
+
+    config_ptr config_;
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit with_t(multiplexer* mpx);
+
+  with_t(with_t&&) noexcept;
+
+  with_t& operator=(with_t&&) noexcept;
+
+  ~with_t();
+
+  // -- methods for building the UDP socket ------------------------------------
+
+  /// Sets an error handler.
+  template <class OnError>
+  [[nodiscard]] with_t&& on_error(OnError fn) && {
+    static_assert(std::is_invocable_v<OnError, const error&>);
+    using impl_t = callback_impl<OnError, void(const error&)>;
+    set_on_error(std::make_unique<impl_t>(std::move(fn)));
+    return std::move(*this);
+  }
+
+  /// Creates a new factory object for a socket that binds to the given `port`
+  /// and `bind_address`.
+  /// @param port Port number to bind to. Passing 0 binds to any free port.
+  /// @param bind_address IP address to bind to. Default is an empty string,
+  ///                     which binds to all IPv4 addresses.
+  /// @param reuse_addr Whether to set the SO_REUSEADDR option on the socket.
+  /// @returns a `binding` object initialized with the given parameters.
+  [[nodiscard]] binding bind(uint16_t port,
+                             std::string bind_address = std::string{},
+                             bool reuse_addr = true) &&;
+
+  /// Creates a new factory object for the given UDP socket.
+  /// @param fd A bound UDP socket. The transport takes ownership of `fd`.
+  /// @returns a `binding` object that will use the given socket.
+  [[nodiscard]] binding bind(udp_datagram_socket fd) &&;
+
+private:
+  using on_error_callback = unique_callback_ptr<void(const error&)>;
+
+  void set_on_error(on_error_callback ptr);
+
+  config_ptr config_;
+};
+
+} // namespace caf::net::udp
@@ -0,0 +1,157 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/net/udp/with.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/net/ip.hpp"
+#include "caf/net/multiplexer.hpp"
+#include "caf/net/socket.hpp"
+#include "caf/net/udp_datagram_socket.hpp"
+
+#include "caf/flow/observable.hpp"
+#include "caf/flow/observable_builder.hpp"
+#include "caf/flow/scoped_coordinator.hpp"
+#include "caf/ipv4_address.hpp"
+
+#include <latch>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+using namespace std::literals;
+
+namespace {
+
+struct fixture {
+  fixture() {
+    mpx = net::multiplexer::make(nullptr);
+    std::ignore = mpx->init();
+    mpx_thread = std::thread{[mpx = mpx] {
+      mpx->set_thread_id();
+      mpx->run();
+    }};
+  }
+
+  ~fixture() {
+    mpx->shutdown();
+    mpx_thread.join();
+  }
+
+  // Creates a UDP socket on the loopback interface and returns its endpoint.
+  std::pair<net::udp_datagram_socket, ip_endpoint> make_socket() {
+    auto ep = ip_endpoint{ipv4_address::loopback(), 0};
+    auto fd = net::make_udp_datagram_socket(ep);
+    if (!fd)
+      CAF_RAISE_ERROR("failed to create a UDP socket");
+    auto port = net::local_port(*fd);
+    if (!port)
+      CAF_RAISE_ERROR("failed to retrieve the port of a UDP socket");
+    ep.port(*port);
+    return {*fd, ep};
+  }
+
+  static chunk make_payload(int value) {
+    auto str = std::to_string(value);
+    return chunk{as_bytes(std::span{str})};
+  }
+
+  static int read_payload(const chunk& payload) {
+    auto bytes = payload.bytes();
+    auto str = std::string_view{reinterpret_cast<const char*>(bytes.data()),
+                                bytes.size()};
+    return std::stoi(std::string{str});
+  }
+
+  net::multiplexer_ptr mpx;
+  std::thread mpx_thread;
+};
+
+} // namespace
+
+WITH_FIXTURE(fixture) {
+
+TEST("a UDP transport connects flows of datagrams to a socket") {
+  auto offload = false;
+  SECTION("sending and receiving with regular system calls") {
+    offload = false;
+  }
+  SECTION("sending and receiving with GSO and GRO") {
+    // Note: the transport falls back to regular system calls if the platform
+    //       does not support GSO or GRO.
+    offload = true;
+  }
+  auto [fd1, ep1] = make_socket();
+  auto [fd2, ep2] = make_socket();
+  auto received = std::make_shared<std::vector<int>>();
+  auto senders = std::make_shared<std::vector<ip_endpoint>>();
+  auto done = std::make_shared<std::latch>(1);
+  auto receiver = std::thread{};
+  auto sender = std::thread{};
+  // Start the receiving side: collect 100 datagrams, then stop.
+  auto rx = net::udp::with(mpx.get())
+              .bind(fd2)
+              .max_batch_size(8)
+              .gro(offload)
+              .start([&receiver, received, senders, done](auto pull, auto) {
+                receiver = std::thread{[pull, received, senders, done] {
+                  auto self = flow::scoped_coordinator::make();
+                  pull.observe_on(self.get())
+                    .take(100)
+                    .do_finally([done] { done->count_down(); })
+                    .for_each([received, senders](const net::udp::datagram& x) {
+                      received->push_back(read_payload(x.payload));
+                      senders->push_back(x.endpoint);
+                    });
+                  self->run();
+                }};
+              });
+  require(rx.has_value());
+  // Start the sending side: send 100 datagrams of equal size.
+  auto tx = net::udp::with(mpx.get())
+              .bind(fd1)
+              .max_batch_size(16)
+              .gso(offload)
+              .start([&sender, dst = ep2](auto, auto push) {
+                sender = std::thread{[push, dst] {
+                  auto self = flow::scoped_coordinator::make();
+                  self->make_observable()
+                    .iota(100)
+                    .take(100)
+                    .map([dst](int x) {
+                      return net::udp::datagram{dst, make_payload(x)};
+                    })
+                    .subscribe(push);
+                  self->run();
+                }};
+              });
+  require(tx.has_value());
+  done->wait();
+  receiver.join();
+  sender.join();
+  // Datagrams on the loopback device arrive in order and unmodified.
+  require_eq(received->size(), 100u);
+  for (size_t i = 0; i < received->size(); ++i)
+    check_eq(received->at(i), 100 + static_cast<int>(i));
+  for (auto& ep : *senders)
+    check_eq(ep, ep1);
+  rx->dispose();
+  tx->dispose();
+}
+
+TEST("the UDP transport reports errors for invalid bind addresses") {
+  auto reported = error{};
+  auto res = net::udp::with(mpx.get())
+               .on_error([&reported](const error& what) { reported = what; })
+               .bind(0, "256.0.0.1.invalid")
+               .start([](auto, auto) {});
+  check(!res.has_value());
+  check(reported.valid());
+}
+
+} // WITH_FIXTURE(fixture)
@@ -14,8 +14,14 @@
 #include "caf/ip_endpoint.hpp"
 #include "caf/log/net.hpp"
 
+#include <algorithm>
+#include <array>
 #include <span>
 
+#ifdef CAF_LINUX
+#  include <netinet/udp.h>
+#endif
+
 namespace {
 
 #if defined(CAF_WINDOWS) || defined(CAF_MACOS) || defined(CAF_IOS)             \
@@ -114,4 +120,158 @@ ptrdiff_t write(udp_datagram_socket x, const_byte_span buf, ip_endpoint ep) {
                   static_cast<socklen_t>(len));
 }
 
+#if defined(CAF_LINUX) && defined(UDP_SEGMENT) && defined(UDP_GRO)
+
+namespace {
+
+/// Limits how many datagrams we pass to `recvmmsg` and `sendmmsg` at once.
+constexpr size_t max_mmsg_batch = 64;
+
+socklen_t sockaddr_len(const ip_endpoint& ep) {
+  return ep.address().embeds_v4() ? sizeof(sockaddr_in) : sizeof(sockaddr_in6);
+}
+
+} // namespace
+
+ptrdiff_t read(udp_datagram_socket x, std::span<udp_read_slot> slots) {
+  using ctrl_buf = std::array<char, CMSG_SPACE(sizeof(int))>;
+  auto n = std::min(slots.size(), max_mmsg_batch);
+  if (n == 0)
+    return 0;
+  std::array<mmsghdr, max_mmsg_batch> hdrs;
+  std::array<iovec, max_mmsg_batch> iovs;
+  std::array<sockaddr_storage, max_mmsg_batch> addrs;
+  alignas(cmsghdr) std::array<ctrl_buf, max_mmsg_batch> ctrl;
+  memset(hdrs.data(), 0, n * sizeof(mmsghdr));
+  for (size_t i = 0; i < n; ++i) {
+    iovs[i].iov_base = slots[i].buf.data();
+    iovs[i].iov_len = slots[i].buf.size();
+    auto& hdr = hdrs[i].msg_hdr;
+    hdr.msg_name = &addrs[i];
+    hdr.msg_namelen = sizeof(sockaddr_storage);
+    hdr.msg_iov = &iovs[i];
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = ctrl[i].data();
+    hdr.msg_controllen = ctrl[i].size();
+  }
+  // MSG_WAITFORONE: only block for the first datagram on blocking sockets.
+  auto res = ::recvmmsg(x.id, hdrs.data(), static_cast<unsigned>(n),
+                        MSG_WAITFORONE, nullptr);
+  if (res <= 0)
+    return res;
+  for (size_t i = 0; i < static_cast<size_t>(res); ++i) {
+    auto& slot = slots[i];
+    auto& hdr = hdrs[i].msg_hdr;
+    slot.size = std::min(static_cast<size_t>(hdrs[i].msg_len), slot.buf.size());
+    slot.truncated = (hdr.msg_flags & MSG_TRUNC) != 0;
+    slot.segment_size = 0;
+    std::ignore = convert(addrs[i], slot.source);
+    for (auto* cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+      if (cmsg->cmsg_level == IPPROTO_UDP && cmsg->cmsg_type == UDP_GRO) {
+        int segment_size = 0;
+        memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(int));
+        if (segment_size > 0 && static_cast<size_t>(segment_size) < slot.size)
+          slot.segment_size = static_cast<size_t>(segment_size);
+      }
+    }
+  }
+  return res;
+}
+
+ptrdiff_t write(udp_datagram_socket x, std::span<const udp_write_slot> slots) {
+  using ctrl_buf = std::array<char, CMSG_SPACE(sizeof(uint16_t))>;
+  auto n = std::min(slots.size(), max_mmsg_batch);
+  if (n == 0)
+    return 0;
+  std::array<mmsghdr, max_mmsg_batch> hdrs;
+  std::array<iovec, max_mmsg_batch> iovs;
+  std::array<sockaddr_storage, max_mmsg_batch> addrs;
+  alignas(cmsghdr) std::array<ctrl_buf, max_mmsg_batch> ctrl;
+  memset(hdrs.data(), 0, n * sizeof(mmsghdr));
+  for (size_t i = 0; i < n; ++i) {
+    auto& slot = slots[i];
+    convert(slot.destination, addrs[i]);
+    iovs[i].iov_base = const_cast<std::byte*>(slot.buf.data());
+    iovs[i].iov_len = slot.buf.size();
+    auto& hdr = hdrs[i].msg_hdr;
+    hdr.msg_name = &addrs[i];
+    hdr.msg_namelen = sockaddr_len(slot.destination);
+    hdr.msg_iov = &iovs[i];
+    hdr.msg_iovlen = 1;
+    if (slot.segment_size > 0 && slot.segment_size < slot.buf.size()) {
+      hdr.msg_control = ctrl[i].data();
+      hdr.msg_controllen = ctrl[i].size();
+      auto* cmsg = CMSG_FIRSTHDR(&hdr);
+      cmsg->cmsg_level = IPPROTO_UDP;
+      cmsg->cmsg_type = UDP_SEGMENT;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+      auto segment_size = static_cast<uint16_t>(slot.segment_size);
+      memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(uint16_t));
+    }
+  }
+  return ::sendmmsg(x.id, hdrs.data(), static_cast<unsigned>(n),
+                    no_sigpipe_io_flag);
+}
+
+error allow_udp_gro(udp_datagram_socket x, bool new_value) {
+  auto lg = log::net::trace("x = {}, new_value = {}", x, new_value);
+  int value = new_value ? 1 : 0;
+  CAF_NET_SYSCALL("setsockopt", res, !=, 0,
+                  setsockopt(x.id, IPPROTO_UDP, UDP_GRO, &value,
+                             static_cast<socket_size_type>(sizeof(value))));
+  return none;
+}
+
+bool udp_gso_supported() noexcept {
+  return true;
+}
+
+#else // CAF_LINUX && UDP_SEGMENT && UDP_GRO
+
+ptrdiff_t read(udp_datagram_socket x, std::span<udp_read_slot> slots) {
+  ptrdiff_t count = 0;
+  for (auto& slot : slots) {
+    auto res = read(x, slot.buf, &slot.source);
+    if (res < 0)
+      return count > 0 ? count : res;
+    slot.size = std::min(static_cast<size_t>(res), slot.buf.size());
+    slot.truncated = static_cast<size_t>(res) > slot.buf.size();
+    slot.segment_size = 0;
+    ++count;
+  }
+  return count;
+}
+
+ptrdiff_t write(udp_datagram_socket x, std::span<const udp_write_slot> slots) {
+  ptrdiff_t count = 0;
+  for (auto& slot : slots) {
+    // Without GSO, we split the payload into individual datagrams manually.
+    auto segment_size = slot.segment_size > 0 ? slot.segment_size
+                                              : slot.buf.size();
+    auto bytes = slot.buf;
+    do {
+      auto segment = bytes.first(std::min(segment_size, bytes.size()));
+      if (write(x, segment, slot.destination) < 0)
+        return count > 0 ? count : -1;
+      bytes = bytes.subspan(segment.size());
+    } while (!bytes.empty());
+    ++count;
+  }
+  return count;
+}
+
+error allow_udp_gro(udp_datagram_socket x, bool) {
+  if (x == invalid_socket)
+    return sec::socket_invalid;
+  return make_error(sec::unsupported_operation,
+                    "UDP GRO is not available on this platform");
+}
+
+bool udp_gso_supported() noexcept {
+  return false;
+}
+
+#endif // CAF_LINUX && UDP_SEGMENT && UDP_GRO
+
 } // namespace caf::net
@@ -10,7 +10,9 @@
 #include "caf/byte_span.hpp"
 #include "caf/detail/net_export.hpp"
 #include "caf/fwd.hpp"
+#include "caf/ip_endpoint.hpp"
 
+#include <span>
 #include <vector>
 
 namespace caf::net {
@@ -23,6 +25,38 @@ struct CAF_NET_EXPORT udp_datagram_socket : datagram_socket {
   using super::super;
 };
 
+/// Stores a single datagram for batched reads.
+struct udp_read_slot {
+  /// Storage for the payload of the datagram.
+  byte_span buf;
+
+  /// Number of received Bytes.
+  size_t size = 0;
+
+  /// Size of the individual datagrams if the OS has coalesced multiple
+  /// datagrams from the same source into `buf` (GRO), 0 otherwise.
+  size_t segment_size = 0;
+
+  /// Stores whether the datagram did not fit into `buf`.
+  bool truncated = false;
+
+  /// Address of the sender.
+  ip_endpoint source;
+};
+
+/// Describes a single outgoing datagram for batched writes.
+struct udp_write_slot {
+  /// The payload of the datagram.
+  const_byte_span buf;
+
+  /// Instructs the OS to split `buf` into datagrams of this size (GSO). A
+  /// value of 0 sends `buf` as a single datagram.
+  size_t segment_size = 0;
+
+  /// Address of the receiver.
+  ip_endpoint destination;
+};
+
 /// Creates a `udp_datagram_socket` bound to given port.
 /// @param ep ip_endpoint that contains the port to bind to. Pass port '0' to
 ///           bind to any unused port - The endpoint will be updated with the
@@ -56,4 +90,34 @@ ptrdiff_t CAF_NET_EXPORT read(udp_datagram_socket x, byte_span buf,
 ptrdiff_t CAF_NET_EXPORT write(udp_datagram_socket x, const_byte_span buf,
                                ip_endpoint ep);
 
+/// Receives up to `slots.size()` datagrams on socket `x`. Uses a single system
+/// call on platforms that support `recvmmsg`.
+/// @param x The UDP socket for receiving datagrams.
+/// @param slots Storage for the received datagrams.
+/// @returns The number of filled slots on success or -1 in case of an error.
+/// @relates udp_datagram_socket
+ptrdiff_t CAF_NET_EXPORT read(udp_datagram_socket x,
+                              std::span<udp_read_slot> slots);
+
+/// Sends up to `slots.size()` datagrams on socket `x`. Uses a single system
+/// call on platforms that support `sendmmsg`.
+/// @param x The UDP socket for sending datagrams.
+/// @param slots The datagrams to send.
+/// @returns The number of sent slots on success or -1 in case of an error.
+/// @relates udp_datagram_socket
+ptrdiff_t CAF_NET_EXPORT write(udp_datagram_socket x,
+                               std::span<const udp_write_slot> slots);
+
+/// Enables or disables generic receive offload (GRO) on `x`.
+/// @returns `sec::unsupported_operation` if the platform has no support for
+///          UDP GRO.
+/// @relates udp_datagram_socket
+error CAF_NET_EXPORT allow_udp_gro(udp_datagram_socket x, bool new_value);
+
+/// Checks whether the platform supports generic segmentation offload (GSO)
+/// for UDP sockets, i.e., whether `write` accepts slots with a non-zero
+/// `segment_size` without splitting them manually.
+/// @relates udp_datagram_socket
+bool CAF_NET_EXPORT udp_gso_supported() noexcept;
+
 } // namespace caf::net
@@ -15,6 +15,9 @@
 #include "caf/ipv6_address.hpp"
 #include "caf/log/test.hpp"
 
+#include <string>
+#include <vector>
+
 using namespace caf;
 using namespace caf::net;
 using namespace caf::net::ip;
@@ -93,4 +96,39 @@ TEST("read and write") {
   check_eq(received, hello_test);
 }
 
+TEST("batched read and write") {
+  // Send three datagrams, the first two with a single slot if GSO is available.
+  auto payload = std::string{"aaabbbc"};
+  auto bytes = as_bytes(std::span{payload});
+  auto out = std::vector<udp_write_slot>{};
+  if (udp_gso_supported()) {
+    out.push_back(udp_write_slot{bytes.first(6), 3, ep});
+  } else {
+    out.push_back(udp_write_slot{bytes.first(3), 0, ep});
+    out.push_back(udp_write_slot{bytes.subspan(3, 3), 0, ep});
+  }
+  out.push_back(udp_write_slot{bytes.subspan(6), 0, ep});
+  require_eq(write(send_socket, out), static_cast<ptrdiff_t>(out.size()));
+  // Read all three datagrams with a single call.
+  auto storage = std::vector<byte_buffer>(4, byte_buffer(16));
+  auto in = std::vector<udp_read_slot>(4);
+  for (size_t i = 0; i < in.size(); ++i)
+    in[i].buf = storage[i];
+  auto received = std::vector<std::string>{};
+  for (int attempt = 0; received.size() < 3 && attempt < 100; ++attempt) {
+    auto res = read(receive_socket, std::span{in}.first(3 - received.size()));
+    if (res <= 0)
+      continue;
+    for (auto& slot : std::span{in}.first(static_cast<size_t>(res))) {
+      check(!slot.truncated);
+      check_eq(slot.segment_size, 0u);
+      check_eq(slot.source.port(), local_port(send_socket).value());
+      auto str = std::string{reinterpret_cast<char*>(slot.buf.data()),
+                             slot.size};
+      received.push_back(str);
+    }
+  }
+  check_eq(received, std::vector<std::string>{"aaa", "bbb", "c"});
+}
+
 } // WITH_FIXTURE(fixture)
@@ -784,6 +784,10 @@ public:
     return ++ids_;
   }
 
+  actor_id next_actor_ids(size_t count) override {
+    return ids_.fetch_add(count) + 1;
+  }
+
   actor_id latest_actor_id() const override {
     return ids_.load();
   }
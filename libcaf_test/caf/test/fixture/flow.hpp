@@ -16,6 +16,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <span>
 #include <utility>
 
 namespace caf::test::fixture {
@@ -232,6 +233,31 @@ public:
     }
   };
 
+  /// Similar to @ref auto_observer but accepts batches and records the size
+  /// of each batch. Useful for testing the batch path of operators.
+  template <class T>
+  class batch_observer : public auto_observer<T> {
+  public:
+    using super = auto_observer<T>;
+
+    using super::super;
+
+    void on_next_batch(std::span<const T> items) override {
+      batch_sizes.push_back(items.size());
+      for (const auto& item : items)
+        passive_observer<T>::on_next(item);
+      if (this->sub)
+        this->sub.request(items.size());
+    }
+
+    bool accepts_batches() const noexcept override {
+      return true;
+    }
+
+    /// Stores the size of each batch received via `on_next_batch`.
+    std::vector<size_t> batch_sizes;
+  };
+
   /// A subscription that records cumulative downstream demand.
   class counting_sub : public caf::flow::subscription::impl_base {
   public:
@@ -308,6 +334,12 @@ public:
     return coordinator()->add_child(std::in_place_type<auto_observer<T>>);
   }
 
+  /// Returns a new batch observer.
+  template <class T>
+  intrusive_ptr<batch_observer<T>> make_batch_observer() {
+    return coordinator()->add_child(std::in_place_type<batch_observer<T>>);
+  }
+
   /// Returns a new canceling observer. The subscriber will either call `cancel`
   /// on its subscription immediately in `on_subscribe` or wait until the first
   /// call to `on_next` when setting `accept_first` to `true`. If `auto_request`
@@ -0,0 +1,223 @@
+#!/usr/bin/env python3
+
+# Renders binary log segments, as written by the default logger with
+# `caf.logger.file.encoding = "binary"`, to text or JSON.
+#
+# usage: decode-binary-log.py [--format FORMAT | --json] FILE [FILE...]
+#
+# Segments are sorted by their sequence number before rendering. The text
+# output uses the same format specifiers as `caf.logger.file.format`.
+
+import argparse
+import datetime
+import json
+import os
+import struct
+import sys
+
+MAGIC = b'CAFBLOG\0'
+
+HEADER_SIZE = 32
+
+DEFAULT_FORMAT = '%r %c %p %a %t %M %F:%L %m%n'
+
+STRING_RECORD = 1
+LEVEL_RECORD = 2
+EVENT_RECORD = 3
+
+NULL_FIELD = 0
+BOOL_FIELD = 1
+INT_FIELD = 2
+UINT_FIELD = 3
+DOUBLE_FIELD = 4
+STRING_FIELD = 5
+LIST_FIELD = 6
+
+
+class Reader:
+    def __init__(self, buf, pos=0):
+        self.buf = buf
+        self.pos = pos
+
+    def read(self, fmt):
+        result = struct.unpack_from('<' + fmt, self.buf, self.pos)
+        self.pos += struct.calcsize('<' + fmt)
+        return result[0]
+
+    def read_bytes(self, size):
+        result = self.buf[self.pos:self.pos + size]
+        self.pos += size
+        return result.decode('utf-8', errors='replace')
+
+
+class Segment:
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.buf = f.read()
+        if len(self.buf) < HEADER_SIZE or self.buf[:8] != MAGIC:
+            raise ValueError(path + ': not a binary CAF log segment')
+        self.path = path
+        self.version, _, self.sequence, self.t0 = struct.unpack_from(
+            '<IIQq', self.buf, 8)
+
+    def events(self):
+        strings = {}
+        levels = []
+        src = Reader(self.buf, HEADER_SIZE)
+        while src.pos + 4 <= len(self.buf):
+            size = src.read('I')
+            if size == 0:
+                return
+            end = src.pos + size
+            kind = src.read('B')
+            if kind == STRING_RECORD:
+                key = src.read('I')
+                strings[key] = src.read_bytes(end - src.pos)
+            elif kind == LEVEL_RECORD:
+                level = src.read('I')
+                levels.append((level, src.read_bytes(end - src.pos)))
+                levels.sort(reverse=True)
+            elif kind == EVENT_RECORD:
+                yield self.read_event(src, strings, levels)
+            src.pos = end
+
+    def read_event(self, src, strings, levels):
+        ev = {}
+        ev['timestamp'] = src.read('q')
+        level = src.read('I')
+        ev['level'] = level
+        ev['priority'] = next((name for lvl, name in levels if level >= lvl),
+                              'OFF')
+        ev['component'] = strings.get(src.read('I'), '')
+        ev['file'] = strings.get(src.read('I'), '')
+        ev['function'] = strings.get(src.read('I'), '')
+        ev['line'] = src.read('I')
+        ev['actor'] = src.read('Q')
+        ev['thread'] = src.read('Q')
+        ev['message'] = src.read_bytes(src.read('I'))
+        ev['fields'] = read_fields(src, strings)
+        ev['runtime'] = (ev['timestamp'] - self.t0) // 1000000
+        return ev
+
+
+def read_fields(src, strings):
+    result = []
+    for _ in range(src.read('I')):
+        key = strings.get(src.read('I'), '')
+        tag = src.read('B')
+        if tag == NULL_FIELD:
+            value = None
+        elif tag == BOOL_FIELD:
+            value = src.read('B') != 0
+        elif tag == INT_FIELD:
+            value = src.read('q')
+        elif tag == UINT_FIELD:
+            value = src.read('Q')
+        elif tag == DOUBLE_FIELD:
+            value = src.read('d')
+        elif tag == STRING_FIELD:
+            value = src.read_bytes(src.read('I'))
+        elif tag == LIST_FIELD:
+            value = read_fields(src, strings)
+        else:
+            raise ValueError('invalid field tag: ' + str(tag))
+        result.append((key, value))
+    return result
+
+
+def render_fields(fields):
+    parts = []
+    for key, value in fields:
+        if value is None:
+            parts.append(key + ' = null')
+        elif isinstance(value, list):
+            parts.append(key + ' { ' + render_fields(value) + ' }')
+        elif isinstance(value, bool):
+            parts.append(key + ' = ' + ('true' if value else 'false'))
+        else:
+            parts.append(key + ' = ' + str(value))
+    return ', '.join(parts)
+
+
+def render_date(ns):
+    ts = datetime.datetime.fromtimestamp(ns / 1e9)
+    return ts.isoformat(timespec='milliseconds')
+
+
+def render_text(fmt, ev):
+    out = []
+    i = 0
+    while i < len(fmt):
+        ch = fmt[i]
+        if ch != '%' or i + 1 == len(fmt):
+            out.append(ch)
+            i += 1
+            continue
+        spec = fmt[i + 1]
+        i += 2
+        if spec == 'c':
+            out.append(ev['component'])
+        elif spec == 'C':
+            out.append('null')
+        elif spec == 'd':
+            out.append(render_date(ev['timestamp']))
+        elif spec == 'F':
+            out.append(ev['file'])
+        elif spec == 'L':
+            out.append(str(ev['line']))
+        elif spec == 'M':
+            out.append(ev['function'])
+        elif spec == 'n':
+            out.append('\n')
+        elif spec == 'p':
+            out.append(ev['priority'])
+        elif spec == 'r':
+            out.append(str(ev['runtime']))
+        elif spec == 't':
+            out.append(str(ev['thread']))
+        elif spec == 'a':
+            out.append('actor' + str(ev['actor']))
+        elif spec == '%':
+            out.append('%')
+        elif spec == 'm':
+            out.append(ev['message'])
+            if ev['fields']:
+                out.append(' ; ' + render_fields(ev['fields']))
+        else:
+            sys.stderr.write('invalid field specifier in format string: '
+                             + spec + '\n')
+    return ''.join(out)
+
+
+def to_json_fields(fields):
+    result = {}
+    for key, value in fields:
+        result[key] = to_json_fields(value) if isinstance(value, list) else value
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decodes binary CAF logs.')
+    parser.add_argument('--format', default=DEFAULT_FORMAT,
+                        help='text format (default: %(default)s)')
+    parser.add_argument('--json', action='store_true',
+                        help='print one JSON object per line')
+    parser.add_argument('files', nargs='+', help='binary log segments')
+    args = parser.parse_args()
+    segments = []
+    for path in args.files:
+        if os.path.getsize(path) == 0:
+            continue
+        segments.append(Segment(path))
+    segments.sort(key=lambda seg: seg.sequence)
+    for seg in segments:
+        for ev in seg.events():
+            if args.json:
+                ev['fields'] = to_json_fields(ev['fields'])
+                sys.stdout.write(json.dumps(ev) + '\n')
+            else:
+                sys.stdout.write(render_text(args.format, ev))
+
+
+if __name__ == '__main__':
+    main()